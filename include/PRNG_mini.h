@@ -1,3 +1,9 @@
+#ifndef PRNG_MINI_H
+#define PRNG_MINI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
 #if defined(_WIN32)
 #ifndef PRNG_MINI_EXPORTS
 #define PRNG_MINI_API __declspec(dllexport)
@@ -6,6 +12,10 @@
 #endif
 #endif
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /// 
 /// @brief Safe zeroization and free of a memory
 /// @details Use this function to prevent a heap error.
@@ -35,6 +45,372 @@ PRNG_MINI_API
 #endif
 int pm_get_random_bytes(void** buffer, int length);
 
+///
+/// @brief PRNG mini - device based - in-place random bytes generation
+/// @details Fills caller-owned memory with cryptographically secure random bytes.
+///          Unlike pm_get_random_bytes() the buffer is never allocated or released here.
+/// Usage: uint8_t buffer[64]; pm_fill_random_bytes(buffer, sizeof(buffer));
+/// @param buffer Pointer to memory where random bytes will be written.
+/// @param length Number of bytes to generate.
+/// @return 0 on success,
+///         non-zero error code on failure.
+///         -1 - invalid arguments.
+///         status < -1 - same device error codes as pm_get_random_bytes().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_fill_random_bytes(void* buffer, size_t length);
+
+///
+/// @brief Allocates a buffer suited for large random fills.
+/// @details Buffers of 2 MiB and more are mapped directly and, where supported,
+///          advised to use transparent huge pages. Smaller buffers use malloc.
+///          Release with pm_free_large() passing the same length.
+/// @param length Number of bytes to allocate.
+/// @return Pointer to the allocation, NULL on failure.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+void* pm_alloc_large(size_t length);
+
+///
+/// @brief Safe zeroization and release of a buffer from pm_alloc_large()
+/// @param buffer Pointer returned by pm_alloc_large() or pm_get_random_bytes_large().
+/// @param length Length passed at allocation time; the whole buffer is zeroized.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+void pm_free_large(void* buffer, size_t length);
+
+///
+/// @brief PRNG mini - device based - 64-bit length random bytes generation
+/// @details Same contract as pm_get_random_bytes() without the 2 GiB cap.
+///          A NULL *buffer is allocated with pm_alloc_large() and must be released
+///          with pm_free_large(); it is released on failure and *buffer is reset to NULL.
+///          A non-NULL *buffer is filled in place and never released here.
+/// Allocate: uint8_t* buffer = NULL;
+/// Usage: ...bytes_large(&buffer,...);
+/// @param buffer Pointer to memory of Pointer to memory where random bytes will be written.
+/// @param length Number of bytes to generate.
+/// @return 0 on success,
+///         non-zero error code on failure.
+///         -1 - invalid arguments.
+///         -2 - memory allocation failed.
+///         status < -1 - same device error codes as pm_get_random_bytes().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_get_random_bytes_large(void** buffer, size_t length);
+
+///
+/// @brief Streams random bytes into a file.
+/// @details The file is created (mode 0600) or truncated. Generation and writing run
+///          as two overlapped stages over a pair of large buffers, so the device and the
+///          disk are kept busy at the same time. Buffers are zeroized before release.
+/// @param path Path of the output file.
+/// @param size Number of random bytes to write.
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments.
+///         -2 - memory allocation or thread creation failed.
+///         -3 - random bytes generation failed.
+///         -4 - the file could not be opened.
+///         -5 - writing to the file failed.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_fill_file(const char* path, uint64_t size);
+
+///
+/// @brief Streams random bytes into an open file descriptor.
+/// @details Same pipeline as pm_fill_file(); bytes are written at the current offset
+///          and the descriptor is left open.
+/// @param fd Descriptor opened for writing (a CRT descriptor on Windows).
+/// @param size Number of random bytes to write.
+/// @return Same error codes as pm_fill_file(), except -4.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_fill_fd(int fd, uint64_t size);
+
+///
+/// @brief State layouts of the buffered generator.
+/// @details PM_BUFFER_THREAD_LOCAL - one 4 KiB buffer per thread, no locking (default).
+///          PM_BUFFER_GLOBAL_LOCKED - one buffer shared by all threads behind a lock.
+///          PM_BUFFER_PER_CPU - one buffer per CPU accessed through restartable sequences;
+///          memory scales with cores instead of threads. Linux x86_64 only, other
+///          platforms fall back to PM_BUFFER_THREAD_LOCAL.
+///
+enum pm_buffer_mode
+{
+    PM_BUFFER_THREAD_LOCAL = 0,
+    PM_BUFFER_GLOBAL_LOCKED = 1,
+    PM_BUFFER_PER_CPU = 2
+};
+
+///
+/// @brief Selects how the buffered generator keeps its state.
+/// @param mode One of pm_buffer_mode.
+/// @return The mode now in effect (PM_BUFFER_PER_CPU may fall back to
+///         PM_BUFFER_THREAD_LOCAL), -1 for an unknown mode.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_buffered_set_mode(int mode);
+
+///
+/// @brief Returns the mode in effect for the buffered generator.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_buffered_get_mode(void);
+
+///
+/// @brief PRNG mini - buffered - random 64-bit word
+/// @details Serves words from a 4 KiB buffer of device output instead of a device
+///          read per call. Thread-safe in every mode; a child process discards the
+///          buffers it inherits through fork().
+/// @param value Output word.
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         -2 - per-thread state allocation failed.
+///         other negative - device error codes as pm_fill_random_bytes().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_buffered_u64(uint64_t* value);
+
+///
+/// @brief PRNG mini - buffered - random bytes generation
+/// @details Small requests are served from the buffered generator; requests of
+///          4 KiB or more go straight to the device.
+/// @param buffer Pointer to memory where random bytes will be written.
+/// @param length Number of bytes to generate.
+/// @return Same error codes as pm_buffered_u64().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_buffered_bytes(void* buffer, size_t length);
+
+///
+/// @brief Runs the randomness service daemon in the calling thread.
+/// @details Creates a shared-memory ring of 4 KiB blocks, keeps it filled with
+///          device randomness and hands the ring to processes connecting on
+///          `socket_path`. Returns once *stop becomes non-zero. Every process
+///          attached to the ring can read its blocks, so the socket is created
+///          with mode 0600 and peers of another user, or on Linux of another pid
+///          namespace, are refused. Blocks taken by a consumer that died before
+///          returning them are reclaimed; on Linux a consumer is matched by pid and
+///          start time, so a reused pid does not hold its blocks.
+///          Unix-like systems only.
+/// @param socket_path Filesystem path of the Unix socket.
+/// @param block_count Number of blocks in the ring (at least 2).
+/// @param stop Flag polled by the daemon loop, e.g. set from a signal handler.
+/// @return 0 after a requested stop, negative error code on failure:
+///         -1 - invalid arguments or unsupported platform.
+///         -2 - shared memory setup failed.
+///         -3 - random bytes generation failed.
+///         -4 - socket setup failed or another daemon serves this path.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_service_run(const char* socket_path, uint32_t block_count, const volatile int* stop);
+
+///
+/// @brief Attaches this process to a running randomness service.
+/// @details After a successful connect pm_service_bytes() draws from the daemon's
+///          ring. Connecting again replaces the previous attachment. The socket file
+///          must belong to this user with no group or other access, and the daemon
+///          must run as this user; otherwise the connection is refused and
+///          pm_service_bytes() keeps using the in-process path.
+/// @param socket_path Filesystem path of the daemon's Unix socket.
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments or unsupported platform.
+///         -2 - mapping the shared memory failed.
+///         -4 - no trusted daemon answered on the socket.
+///         -5 - the daemon's ring has an unexpected layout or version.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_service_connect(const char* socket_path);
+
+///
+/// @brief Detaches this process from the randomness service.
+/// @details Unused bytes held locally are wiped; later draws use the in-process path.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+void pm_service_disconnect(void);
+
+///
+/// @brief PRNG mini - service based - random bytes generation
+/// @details Draws blocks from the attached service's ring. When no service is
+///          attached or the ring is empty (daemon busy or gone), the remainder is
+///          generated in-process with pm_fill_random_bytes().
+/// @param buffer Pointer to memory where random bytes will be written.
+/// @param length Number of bytes to generate.
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         other negative - device error codes from the in-process fallback.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_service_bytes(void* buffer, size_t length);
+
+///
+/// @brief Reports how this process has been served since it started.
+/// @param service_blocks Receives the number of blocks taken from the service ring (may be NULL).
+/// @param fallback_calls Receives the number of calls that used the in-process path (may be NULL).
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+void pm_service_stats(uint64_t* service_blocks, uint64_t* fallback_calls);
+
+///
+/// @brief PRNG mini - device based - uniform big integer in [1, n)
+/// @details Samples a value uniformly below a public modulus, e.g. an ECDSA nonce
+///          below the P-256 group order or an RSA blinding factor. Candidates are
+///          masked to the bit length of n and rejected until in range; the range
+///          check is constant-time. Modulus and output are big-endian.
+/// @param out Receives `len` bytes, zero-padded to the width of the modulus.
+/// @param modulus Modulus n (at least 2), big-endian.
+/// @param len Byte length of modulus and output, 1 to 512 (up to 4096 bits).
+/// @return 0 on success,
+///         -1 - invalid arguments (including n < 2).
+///         other negative - device error codes as pm_fill_random_bytes().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_random_below(uint8_t* out, const uint8_t* modulus, size_t len);
+
+///
+/// @brief Same as pm_random_below() with little-endian modulus and output,
+///        the convention of Ed25519 and X25519 scalars.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_random_below_le(uint8_t* out, const uint8_t* modulus, size_t len);
+
+///
+/// @brief PRNG mini - device based - many uniform big integers in [1, n)
+/// @details Writes `count` independent values back to back; device reads are
+///          shared across values instead of one per value.
+/// @param out Receives count * len bytes.
+/// @param count Number of values (at least 1).
+/// @param modulus Modulus n (at least 2).
+/// @param len Byte length of modulus and of each value, 1 to 512.
+/// @param little_endian Non-zero for little-endian modulus and output.
+/// @return Same error codes as pm_random_below().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_random_below_batch(uint8_t* out, size_t count, const uint8_t* modulus, size_t len, int little_endian);
+
+///
+/// @brief Size in bytes of nonces from pm_nonce_next() (AES-GCM, ChaCha20-Poly1305).
+///
+#define PM_NONCE_SIZE 12
+
+///
+/// @brief Opaque generator of unique 96-bit AEAD nonces.
+///
+typedef struct pm_nonce_gen pm_nonce_gen;
+
+///
+/// @brief PRNG mini - nonce generator creation
+/// @details Each nonce is a random per-epoch prefix followed by a counter in its
+///          low `counter_bits`, big-endian. Threads reserve blocks of counters
+///          lock-free and issue nonces without system calls.
+///          The generator moves to a new epoch (fresh prefix, counter reset) when
+///          the counters run out, on pm_nonce_rekey() and in a child after fork().
+///          Nonces never repeat within an epoch: encrypt under a fresh key
+///          whenever the reported epoch changes.
+///          Epoch numbers hold the process id in their upper 32 bits, so a child
+///          never reports its parent's numbers. Treat them as opaque and draw each
+///          epoch's key from fresh randomness.
+/// @param gen Receives the generator; release it with pm_nonce_free().
+/// @param counter_bits Counter width, 16 to 64; the remaining bits are random.
+/// @param block_size Counters a thread reserves at once, at least 1.
+/// @param max_per_epoch Nonces per epoch (per key), 0 for the full counter range.
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         -2 - memory allocation failed.
+///         other negative - device error codes as pm_fill_random_bytes().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_nonce_create(pm_nonce_gen** gen, int counter_bits, uint32_t block_size, uint64_t max_per_epoch);
+
+///
+/// @brief PRNG mini - next unique nonce
+/// @param gen Generator from pm_nonce_create().
+/// @param nonce Receives PM_NONCE_SIZE bytes.
+/// @param epoch Receives the epoch of the nonce (may be NULL).
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         other negative - errors starting a new epoch, as pm_nonce_create().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_nonce_next(pm_nonce_gen* gen, uint8_t* nonce, uint64_t* epoch);
+
+///
+/// @brief PRNG mini - many unique nonces
+/// @details All nonces of one call share one epoch; fewer than `count` are written
+///          only when that epoch runs out, and the next call continues in the new one.
+/// @param gen Generator from pm_nonce_create().
+/// @param nonces Receives count * PM_NONCE_SIZE bytes.
+/// @param count Number of nonces wanted, at least 1.
+/// @param epoch Receives the epoch of the written nonces (may be NULL).
+/// @return Number of nonces written (at least 1),
+///         -1 - invalid arguments.
+///         other negative - errors starting a new epoch, as pm_nonce_create().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+long long pm_nonce_batch(pm_nonce_gen* gen, uint8_t* nonces, size_t count, uint64_t* epoch);
+
+///
+/// @brief PRNG mini - start a new nonce epoch, e.g. for scheduled key rotation
+/// @param gen Generator from pm_nonce_create().
+/// @param epoch Receives the new epoch (may be NULL).
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         other negative - errors as pm_nonce_create().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_nonce_rekey(pm_nonce_gen* gen, uint64_t* epoch);
+
+///
+/// @brief Releases a generator. No other thread may be using it.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+void pm_nonce_free(pm_nonce_gen* gen);
+
 ///
 /// @brief PRNG mini - device based - random integers generation
 /// @details Fill the provided buffer with cryptographically secure random bytes.
@@ -114,4 +490,110 @@ int pm_get_license_key(char** output_key, int signature);
 #if defined(_WIN32)
 PRNG_MINI_API
 #endif
-int pm_validate_license_key(const char* key, int signature);
\ No newline at end of file
+int pm_validate_license_key(const char* key, int signature);
+
+///
+/// @brief Immutable set of license keys for issued/revoked lookups.
+/// @details Keep one set of issued keys and one of revoked keys; a key is active
+///          when it is in the first and not in the second.
+///
+typedef struct pm_keyset pm_keyset;
+
+///
+/// @brief Builds an immutable set of license keys.
+/// @details Each key is packed into 11 bytes and filed in a hash-bucketed table with
+///          about four keys per bucket, so a lookup reads one directory entry and one
+///          or two cache lines of records. Duplicate keys are stored once.
+/// @param set Receives the new set; release it with pm_keyset_free().
+/// @param keys License keys in the pm_get_license_key() format.
+/// @param count Number of keys.
+/// @param bloom_bits_per_key Bloom prefilter size in bits per key, 0 to disable.
+///        10 bits per key rejects about 99% of absent keys before the table is read.
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments or a malformed key.
+///         -2 - memory allocation failed.
+///         -5 - big-endian host (the image format is little-endian).
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_keyset_create(pm_keyset** set, const char* const* keys, size_t count, int bloom_bits_per_key);
+
+///
+/// @brief Checks whether a license key belongs to the set.
+/// @param set Set built by pm_keyset_create() or loaded by pm_keyset_open().
+/// @param key Null-terminated license key (e.g., "MNE9-N37G-JC81-AB5B").
+/// @return 1 if the key is in the set, 0 if not or if the key is malformed,
+///         -1 if set is NULL.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_keyset_contains(const pm_keyset* set, const char* key);
+
+///
+/// @brief Checks many license keys at once, overlapping their memory accesses.
+/// @param set Set built by pm_keyset_create() or loaded by pm_keyset_open().
+/// @param keys Null-terminated license keys.
+/// @param count Number of keys.
+/// @param results Receives 1 (present) or 0 (absent or malformed) per key.
+/// @return Number of keys found, -1 on invalid arguments.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+long long pm_keyset_contains_batch(const pm_keyset* set, const char* const* keys, size_t count, uint8_t* results);
+
+///
+/// @brief Returns the number of distinct keys in the set.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+size_t pm_keyset_size(const pm_keyset* set);
+
+///
+/// @brief Writes the set to a file that pm_keyset_open() can map.
+/// @param set Set to serialize.
+/// @param path Output file path (created or truncated).
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments.
+///         -4 - the file could not be opened.
+///         -5 - writing the file failed.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_keyset_save(const pm_keyset* set, const char* path);
+
+///
+/// @brief Maps a set written by pm_keyset_save().
+/// @details The file is mapped read-only and queried in place; nothing is copied
+///          or rebuilt. Opening validates the bucket directory in one sequential
+///          pass, about one byte per key, so it grows with the key count.
+/// @param set Receives the set; release it with pm_keyset_free().
+/// @param path File path.
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments.
+///         -2 - memory allocation or mapping failed.
+///         -4 - the file could not be opened.
+///         -5 - the file is not a valid key set.
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+int pm_keyset_open(pm_keyset** set, const char* path);
+
+///
+/// @brief Releases a set from pm_keyset_create() or pm_keyset_open().
+///
+#if defined(_WIN32)
+PRNG_MINI_API
+#endif
+void pm_keyset_free(pm_keyset* set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PRNG_MINI_H
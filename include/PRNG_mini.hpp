@@ -0,0 +1,511 @@
+#ifndef PRNG_MINI_HPP
+#define PRNG_MINI_HPP
+
+///
+/// @brief PRNG mini - header-only C++17/20 layer over the C API.
+/// @details Engines model UniformRandomBitGenerator, so they plug into <random>,
+///          std::shuffle and std::uniform_int_distribution. Device reads are
+///          amortized over an internal buffer; the per-draw path is inline.
+///          Errors reported by the C API are thrown as pm::random_error.
+///
+
+#include <PRNG_mini.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#ifdef __cpp_lib_span
+#include <span>
+#define PRNG_MINI_HAS_SPAN 1
+#endif
+
+namespace pm
+{
+
+///
+/// @brief Error thrown when the C API reports a failure.
+/// @details status() holds the original negative return code.
+///
+class random_error : public std::runtime_error
+{
+public:
+    explicit random_error(int status)
+        : std::runtime_error("PRNG_mini: random generation failed"), status_(status)
+    {
+    }
+
+    int status() const noexcept { return status_; }
+
+private:
+    int status_;
+};
+
+namespace detail
+{
+
+inline void check(int status)
+{
+    if (status < 0)
+        throw random_error(status);
+}
+
+inline void secure_zero(void* buffer, std::size_t size) noexcept
+{
+    // Volatile stores keep the wipe from being elided as a dead store.
+    volatile unsigned char* p = static_cast<volatile unsigned char*>(buffer);
+    while (size--)
+        *p++ = 0;
+}
+
+///
+/// @brief Rejection threshold for an unbiased draw in [0, range).
+/// @details Values below 2^N mod range are rejected; range == 0 means the full type.
+///
+template <class UInt>
+constexpr UInt rejection_threshold(UInt range) noexcept
+{
+    return range == 0 ? UInt(0) : static_cast<UInt>(static_cast<UInt>(0 - range) % range);
+}
+
+template <class UInt>
+constexpr bool is_power_of_two(UInt range) noexcept
+{
+    return (range & static_cast<UInt>(range - 1)) == 0;
+}
+
+} // namespace detail
+
+///
+/// @brief RAII owner of memory released through pm_free().
+/// @details Replaces manual pm_free(ptr, size) pairs; the whole allocation is
+///          zeroized on destruction. Move-only.
+///
+template <class T>
+class secure_buffer
+{
+    static_assert(std::is_trivially_copyable_v<T>, "secure_buffer holds raw memory only");
+
+public:
+    secure_buffer() noexcept = default;
+
+    /// Throws std::bad_alloc if count * sizeof(T) overflows or allocation fails.
+    explicit secure_buffer(std::size_t count)
+        : data_(allocate(count)), count_(count)
+    {
+    }
+
+    /// Adopts memory allocated by the C API (malloc-based).
+    static secure_buffer adopt(T* data, std::size_t count) noexcept
+    {
+        secure_buffer result;
+        result.data_ = data;
+        result.count_ = count;
+        return result;
+    }
+
+    secure_buffer(secure_buffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), count_(std::exchange(other.count_, 0))
+    {
+    }
+
+    secure_buffer& operator=(secure_buffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            count_ = std::exchange(other.count_, 0);
+        }
+        return *this;
+    }
+
+    secure_buffer(const secure_buffer&) = delete;
+    secure_buffer& operator=(const secure_buffer&) = delete;
+
+    ~secure_buffer() { reset(); }
+
+    void reset() noexcept
+    {
+        if (data_ != nullptr)
+        {
+            detail::secure_zero(data_, count_ * sizeof(T));
+            pm_free(data_, 0);
+        }
+        data_ = nullptr;
+        count_ = 0;
+    }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+
+    T* begin() noexcept { return data_; }
+    T* end() noexcept { return data_ + count_; }
+    const T* begin() const noexcept { return data_; }
+    const T* end() const noexcept { return data_ + count_; }
+
+    T& operator[](std::size_t i) noexcept { return data_[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+#ifdef PRNG_MINI_HAS_SPAN
+    operator std::span<T>() noexcept { return { data_, count_ }; }
+    operator std::span<const T>() const noexcept { return { data_, count_ }; }
+#endif
+
+private:
+    static T* allocate(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        T* data = static_cast<T*>(std::malloc(count * sizeof(T)));
+        if (count != 0 && data == nullptr)
+            throw std::bad_alloc();
+        return data;
+    }
+
+    T* data_ = nullptr;
+    std::size_t count_ = 0;
+};
+
+///
+/// @brief Fills caller-owned memory with device random bytes.
+///
+inline void fill(void* buffer, std::size_t length)
+{
+    if (length != 0)
+        detail::check(pm_fill_random_bytes(buffer, length));
+}
+
+#ifdef PRNG_MINI_HAS_SPAN
+template <class T>
+inline void fill(std::span<T> out)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "fill() writes raw bytes");
+    fill(out.data(), out.size_bytes());
+}
+#endif
+
+///
+/// @brief Allocates and fills a zeroizing buffer of random bytes.
+///
+inline secure_buffer<std::uint8_t> random_bytes(std::size_t length)
+{
+    secure_buffer<std::uint8_t> result(length);
+    fill(result.data(), result.size());
+    return result;
+}
+
+///
+/// @brief Returns a version 4 GUID (36 characters).
+///
+inline std::string guid()
+{
+    char text[37] = { 0 };
+    char* buffer = text;
+    detail::check(pm_get_guid_std(&buffer));
+    return std::string(text, 36);
+}
+
+///
+/// @brief Returns a license key matching the given signature.
+///
+inline std::string license_key(int signature)
+{
+    char* key = nullptr;
+    int size = pm_get_license_key(&key, signature);
+    detail::check(size);
+    std::string result(key);
+    pm_free(key, size);
+    return result;
+}
+
+///
+/// @brief Buffered device engine modelling UniformRandomBitGenerator.
+/// @details Random words are pulled from the device BufferBytes at a time and
+///          handed out by an inline operator(). Each word is wiped from the
+///          buffer once returned, and the buffer is wiped on destruction.
+///          Engines are move-only: a copy would replay the same words.
+///          Not thread-safe; use one engine per thread.
+///
+template <class UIntType = std::uint32_t, std::size_t BufferBytes = 4096>
+class basic_engine
+{
+    static_assert(std::is_unsigned_v<UIntType>, "result_type must be unsigned");
+    static_assert(BufferBytes >= sizeof(UIntType) && BufferBytes % sizeof(UIntType) == 0,
+        "BufferBytes must hold a whole number of words");
+
+public:
+    using result_type = UIntType;
+
+    static constexpr std::size_t buffer_words = BufferBytes / sizeof(UIntType);
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    basic_engine() noexcept = default;
+
+    basic_engine(basic_engine&& other) noexcept
+        : position_(other.position_)
+    {
+        std::memcpy(buffer_, other.buffer_, sizeof(buffer_));
+        other.wipe();
+    }
+
+    basic_engine& operator=(basic_engine&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::memcpy(buffer_, other.buffer_, sizeof(buffer_));
+            position_ = other.position_;
+            other.wipe();
+        }
+        return *this;
+    }
+
+    basic_engine(const basic_engine&) = delete;
+    basic_engine& operator=(const basic_engine&) = delete;
+
+    ~basic_engine() { wipe(); }
+
+    result_type operator()()
+    {
+        if (position_ == buffer_words)
+            refill();
+        result_type value = buffer_[position_];
+        buffer_[position_++] = 0;
+        return value;
+    }
+
+    ///
+    /// @brief Unbiased draw in [Min, Max] with the range fixed at compile time.
+    /// @details Power-of-two ranges reduce to a mask; other ranges use a
+    ///          constant rejection threshold and a modulo by a constant.
+    ///
+    template <result_type Min, result_type Max>
+    result_type uniform()
+    {
+        static_assert(Min <= Max, "uniform<Min, Max>() requires Min <= Max");
+        constexpr result_type range = static_cast<result_type>(Max - Min + 1);
+
+        if constexpr (range == 0)
+        {
+            return (*this)();
+        }
+        else if constexpr (detail::is_power_of_two(range))
+        {
+            return static_cast<result_type>(Min + ((*this)() & (range - 1)));
+        }
+        else
+        {
+            constexpr result_type threshold = detail::rejection_threshold(range);
+            result_type value;
+            do
+            {
+                value = (*this)();
+            } while (value < threshold);
+            return static_cast<result_type>(Min + value % range);
+        }
+    }
+
+    ///
+    /// @brief Unbiased draw in [min, max] (inclusive) with runtime bounds.
+    /// @details Throws std::invalid_argument if min > max.
+    ///
+    result_type uniform(result_type min, result_type max)
+    {
+        if (min > max)
+            throw std::invalid_argument("PRNG_mini: uniform() requires min <= max");
+        const result_type range = static_cast<result_type>(max - min + 1);
+        if (range == 0)
+            return (*this)();
+        if (detail::is_power_of_two(range))
+            return static_cast<result_type>(min + ((*this)() & (range - 1)));
+
+        const result_type threshold = detail::rejection_threshold(range);
+        result_type value;
+        do
+        {
+            value = (*this)();
+        } while (value < threshold);
+        return static_cast<result_type>(min + value % range);
+    }
+
+    ///
+    /// @brief Fills memory with random bytes.
+    /// @details Large requests go straight to the device instead of through the buffer.
+    ///
+    void fill(void* buffer, std::size_t length)
+    {
+        if (length >= BufferBytes)
+        {
+            pm::fill(buffer, length);
+            return;
+        }
+
+        unsigned char* out = static_cast<unsigned char*>(buffer);
+        while (length >= sizeof(result_type))
+        {
+            result_type value = (*this)();
+            std::memcpy(out, &value, sizeof(value));
+            out += sizeof(value);
+            length -= sizeof(value);
+        }
+        if (length != 0)
+        {
+            result_type value = (*this)();
+            std::memcpy(out, &value, length);
+        }
+    }
+
+#ifdef PRNG_MINI_HAS_SPAN
+    template <class T>
+    void fill(std::span<T> out)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "fill() writes raw bytes");
+        fill(out.data(), out.size_bytes());
+    }
+#endif
+
+    void discard(unsigned long long count)
+    {
+        while (count--)
+            (void)(*this)();
+    }
+
+private:
+    void refill()
+    {
+        detail::check(pm_fill_random_bytes(buffer_, sizeof(buffer_)));
+        position_ = 0;
+    }
+
+    void wipe() noexcept
+    {
+        detail::secure_zero(buffer_, sizeof(buffer_));
+        position_ = buffer_words;
+    }
+
+    alignas(64) result_type buffer_[buffer_words] = {};
+    std::size_t position_ = buffer_words;
+};
+
+using engine = basic_engine<std::uint32_t>;
+using engine64 = basic_engine<std::uint64_t>;
+
+///
+/// @brief Engine backed by the library's shared buffered generator.
+/// @details Holds no state of its own, so it is cheap to create and copy.
+///          The buffer lives in the library, per thread, global or per CPU
+///          as selected with pm_buffered_set_mode().
+///
+class buffered_engine
+{
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        std::uint64_t value;
+        detail::check(pm_buffered_u64(&value));
+        return value;
+    }
+};
+
+///
+/// @brief Fills an int array with values in [min, max] (inclusive) from `source`.
+/// @details Unbiased for every range, including [INT_MIN, INT_MAX]: bounds are
+///          widened through unsigned and drawn by rejection from full engine
+///          words, as basic_engine::uniform() does. Takes any engine producing
+///          whole 32- or 64-bit words, e.g. pm::engine, pm::engine64 or
+///          pm::buffered_engine, so repeated calls share its buffer.
+///          Throws std::invalid_argument if min > max.
+///
+template <class Engine>
+inline void fill_integers(Engine& source, int* values, std::size_t count, int min, int max)
+{
+    using word = typename Engine::result_type;
+    static_assert(std::is_unsigned_v<word> && sizeof(word) >= sizeof(std::uint32_t),
+        "fill_integers() needs an engine with 32- or 64-bit words");
+    static_assert(Engine::min() == 0 && Engine::max() == std::numeric_limits<word>::max(),
+        "fill_integers() needs an engine covering its whole word");
+
+    if (min > max)
+        throw std::invalid_argument("PRNG_mini: fill_integers() requires min <= max");
+
+    const std::uint32_t low = static_cast<std::uint32_t>(min);
+    const std::uint32_t span = static_cast<std::uint32_t>(max) - low;
+    // Zero for the full 32-bit range when words are 32 bits wide.
+    const word range = static_cast<word>(static_cast<word>(span) + 1);
+    const word threshold = detail::rejection_threshold(range);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        word drawn;
+        do
+        {
+            drawn = source();
+        } while (drawn < threshold);
+
+        // Adds modulo 2^32 and maps back to int's two's complement range.
+        const std::uint32_t value = low + static_cast<std::uint32_t>(range == 0 ? drawn : drawn % range);
+        values[i] = value > static_cast<std::uint32_t>(std::numeric_limits<int>::max())
+            ? static_cast<int>(value - 0x80000000u) + std::numeric_limits<int>::min()
+            : static_cast<int>(value);
+    }
+}
+
+///
+/// @brief Fills an int array with values in [min, max] (inclusive).
+/// @details Draws from the library's buffered generator (see pm_buffered_set_mode()),
+///          so short calls cost no device read of their own.
+///          Throws std::invalid_argument if min > max.
+///
+inline void fill_integers(int* values, std::size_t count, int min, int max)
+{
+    buffered_engine source;
+    fill_integers(source, values, count, min, max);
+}
+
+#ifdef PRNG_MINI_HAS_SPAN
+template <class Engine>
+inline void fill_integers(Engine& source, std::span<int> out, int min, int max)
+{
+    fill_integers(source, out.data(), out.size(), min, max);
+}
+
+inline void fill_integers(std::span<int> out, int min, int max)
+{
+    fill_integers(out.data(), out.size(), min, max);
+}
+#endif
+
+///
+/// @brief Allocates and fills a zeroizing buffer of integers in [min, max].
+///
+inline secure_buffer<int> random_integers(std::size_t count, int min, int max)
+{
+    if (min > max)
+        throw std::invalid_argument("PRNG_mini: random_integers() requires min <= max");
+    secure_buffer<int> result(count);
+    fill_integers(result.data(), result.size(), min, max);
+    return result;
+}
+
+} // namespace pm
+
+#endif // PRNG_MINI_HPP
@@ -0,0 +1,456 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <PRNG_mini.h>
+
+#include <string.h>
+#include <stdint.h>
+
+// Size of the local pool that serves redraws after a rejected integer sample.
+#define PM_PY_POOL_SIZE 256
+
+typedef struct
+{
+    uint8_t bytes[PM_PY_POOL_SIZE];
+    size_t position;
+} pm_py_pool;
+
+///
+/// @brief Returns the next 64 random bits from the pool, refilling it when empty.
+/// @return 0 on success, non-zero device status on failure.
+///
+static int pm_py_pool_next(pm_py_pool* pool, uint64_t* value)
+{
+    if (pool->position + sizeof(uint64_t) > PM_PY_POOL_SIZE)
+    {
+        int status = pm_fill_random_bytes(pool->bytes, PM_PY_POOL_SIZE);
+        if (status != 0)
+            return status;
+        pool->position = 0;
+    }
+
+    memcpy(value, pool->bytes + pool->position, sizeof(uint64_t));
+    memset(pool->bytes + pool->position, 0, sizeof(uint64_t));
+    pool->position += sizeof(uint64_t);
+    return 0;
+}
+
+///
+/// @brief Item type of a buffer, resolved from its struct format string.
+///
+typedef struct
+{
+    char code;          // struct format character without byte-order prefix
+    int is_signed;
+    int is_float;
+    Py_ssize_t size;
+} pm_py_item;
+
+static int pm_py_parse_format(const Py_buffer* view, pm_py_item* item)
+{
+    const char* format = view->format ? view->format : "B";
+    const uint16_t probe = 1;
+    const int little_endian = *(const uint8_t*)&probe == 1;
+
+    // Native or explicitly native-order formats only; values are written in host order.
+    if (*format == '@' || *format == '=')
+        format++;
+    else if (*format == '<' || *format == '>' || *format == '!')
+    {
+        if ((*format == '<') != little_endian)
+        {
+            PyErr_SetString(PyExc_ValueError, "buffer byte order must match the host");
+            return -1;
+        }
+        format++;
+    }
+
+    if (format[0] == '\0' || format[1] != '\0')
+    {
+        PyErr_Format(PyExc_ValueError, "unsupported buffer format '%s'", view->format);
+        return -1;
+    }
+
+    item->code = format[0];
+    item->size = view->itemsize;
+    item->is_float = (item->code == 'f' || item->code == 'd');
+    item->is_signed = strchr("bhilqn", item->code) != NULL;
+
+    if (!item->is_float && !item->is_signed && strchr("BHILQN", item->code) == NULL)
+    {
+        PyErr_Format(PyExc_ValueError, "unsupported buffer format '%s'", view->format);
+        return -1;
+    }
+    if (item->size != 1 && item->size != 2 && item->size != 4 && item->size != 8)
+    {
+        PyErr_SetString(PyExc_ValueError, "unsupported buffer item size");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int pm_py_get_buffer(PyObject* object, Py_buffer* view)
+{
+    return PyObject_GetBuffer(object, view, PyBUF_WRITABLE | PyBUF_ANY_CONTIGUOUS | PyBUF_FORMAT);
+}
+
+static PyObject* pm_py_device_error(int status)
+{
+    return PyErr_Format(PyExc_OSError, "PRNG_mini: random generation failed (%d)", status);
+}
+
+///
+/// @brief fill_bytes(buffer) - fills any writable buffer with random bytes in place.
+///
+static PyObject* pm_py_fill_bytes(PyObject* self, PyObject* args)
+{
+    (void)self;
+    PyObject* object;
+    if (!PyArg_ParseTuple(args, "O:fill_bytes", &object))
+        return NULL;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(object, &view, PyBUF_WRITABLE | PyBUF_ANY_CONTIGUOUS) != 0)
+        return NULL;
+
+    int status = 0;
+    if (view.len > 0)
+    {
+        Py_BEGIN_ALLOW_THREADS
+        status = pm_fill_random_bytes(view.buf, (size_t)view.len);
+        Py_END_ALLOW_THREADS
+    }
+    PyBuffer_Release(&view);
+
+    if (status != 0)
+        return pm_py_device_error(status);
+    Py_RETURN_NONE;
+}
+
+///
+/// @brief Maps the random words already in the buffer onto [low, low + range).
+/// @details range == 0 means the full width of the item. Each word is rejected when
+///          below 2^bits mod range and redrawn from the pool, so the result is unbiased.
+///          Runs without the GIL.
+///
+static int pm_py_map_integers(uint8_t* data, Py_ssize_t count, Py_ssize_t size, uint64_t low, uint64_t range)
+{
+    const int bits = (int)(size * 8);
+    const uint64_t width_mask = bits == 64 ? UINT64_MAX : (((uint64_t)1 << bits) - 1);
+    uint64_t threshold = 0;
+    if (range != 0)
+        threshold = bits == 64 ? (0 - range) % range : (((uint64_t)1 << bits) - range) % range;
+
+    pm_py_pool pool;
+    pool.position = PM_PY_POOL_SIZE;
+    int status = 0;
+
+    for (Py_ssize_t i = 0; i < count && status == 0; ++i)
+    {
+        uint8_t* slot = data + i * size;
+        uint64_t value = 0;
+
+        switch (size)
+        {
+        case 1: { uint8_t v; memcpy(&v, slot, 1); value = v; break; }
+        case 2: { uint16_t v; memcpy(&v, slot, 2); value = v; break; }
+        case 4: { uint32_t v; memcpy(&v, slot, 4); value = v; break; }
+        default: memcpy(&value, slot, 8); break;
+        }
+
+        if (range != 0)
+        {
+            while (value < threshold)
+            {
+                status = pm_py_pool_next(&pool, &value);
+                if (status != 0)
+                    break;
+                value &= width_mask;
+            }
+            value %= range;
+        }
+
+        value = (value + low) & width_mask; // two's complement wrap for signed items
+
+        switch (size)
+        {
+        case 1: { uint8_t v = (uint8_t)value; memcpy(slot, &v, 1); break; }
+        case 2: { uint16_t v = (uint16_t)value; memcpy(slot, &v, 2); break; }
+        case 4: { uint32_t v = (uint32_t)value; memcpy(slot, &v, 4); break; }
+        default: memcpy(slot, &value, 8); break;
+        }
+    }
+
+    memset(&pool, 0, sizeof(pool));
+    return status;
+}
+
+///
+/// @brief fill_integers(buffer, low, high) - fills an integer buffer with values in [low, high].
+///
+static PyObject* pm_py_fill_integers(PyObject* self, PyObject* args)
+{
+    (void)self;
+    PyObject* object;
+    PyObject* low_object;
+    PyObject* high_object;
+    if (!PyArg_ParseTuple(args, "OOO:fill_integers", &object, &low_object, &high_object))
+        return NULL;
+
+    Py_buffer view;
+    if (pm_py_get_buffer(object, &view) != 0)
+        return NULL;
+
+    pm_py_item item;
+    if (pm_py_parse_format(&view, &item) != 0)
+        goto fail;
+    if (item.is_float)
+    {
+        PyErr_SetString(PyExc_TypeError, "fill_integers() requires an integer buffer");
+        goto fail;
+    }
+
+    const int bits = (int)(item.size * 8);
+    uint64_t low;
+    uint64_t range;
+
+    if (item.is_signed)
+    {
+        long long low_value = PyLong_AsLongLong(low_object);
+        long long high_value = PyLong_AsLongLong(high_object);
+        if (PyErr_Occurred())
+            goto fail;
+
+        long long type_max = bits == 64 ? INT64_MAX : (long long)(((uint64_t)1 << (bits - 1)) - 1);
+        long long type_min = -type_max - 1;
+        if (low_value > high_value || low_value < type_min || high_value > type_max)
+        {
+            PyErr_SetString(PyExc_ValueError, "bounds must satisfy low <= high within the buffer item type");
+            goto fail;
+        }
+        low = (uint64_t)low_value;
+        range = (uint64_t)high_value - (uint64_t)low_value + 1;
+    }
+    else
+    {
+        unsigned long long low_value = PyLong_AsUnsignedLongLong(low_object);
+        unsigned long long high_value = PyLong_AsUnsignedLongLong(high_object);
+        if (PyErr_Occurred())
+            goto fail;
+
+        unsigned long long type_max = bits == 64 ? UINT64_MAX : (((uint64_t)1 << bits) - 1);
+        if (low_value > high_value || high_value > type_max)
+        {
+            PyErr_SetString(PyExc_ValueError, "bounds must satisfy low <= high within the buffer item type");
+            goto fail;
+        }
+        low = low_value;
+        range = high_value - low_value + 1;
+    }
+
+    // A range covering the whole item width maps every word to itself.
+    if (bits < 64 && range == ((uint64_t)1 << bits))
+        range = 0;
+
+    int status = 0;
+    if (view.len > 0)
+    {
+        Py_BEGIN_ALLOW_THREADS
+        status = pm_fill_random_bytes(view.buf, (size_t)view.len);
+        if (status == 0)
+            status = pm_py_map_integers((uint8_t*)view.buf, view.len / item.size, item.size, low, range);
+        Py_END_ALLOW_THREADS
+    }
+    PyBuffer_Release(&view);
+
+    if (status != 0)
+        return pm_py_device_error(status);
+    Py_RETURN_NONE;
+
+fail:
+    PyBuffer_Release(&view);
+    return NULL;
+}
+
+///
+/// @brief fill_doubles(buffer) - fills a float32/float64 buffer with values in [0, 1).
+/// @details Uses the top 53 (or 24) bits of each random word, so every value is an
+///          exact multiple of 2^-53 (or 2^-24).
+///
+static PyObject* pm_py_fill_doubles(PyObject* self, PyObject* args)
+{
+    (void)self;
+    PyObject* object;
+    if (!PyArg_ParseTuple(args, "O:fill_doubles", &object))
+        return NULL;
+
+    Py_buffer view;
+    if (pm_py_get_buffer(object, &view) != 0)
+        return NULL;
+
+    pm_py_item item;
+    if (pm_py_parse_format(&view, &item) != 0)
+    {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    if (!item.is_float)
+    {
+        PyBuffer_Release(&view);
+        PyErr_SetString(PyExc_TypeError, "fill_doubles() requires a float or double buffer");
+        return NULL;
+    }
+
+    int status = 0;
+    if (view.len > 0)
+    {
+        Py_BEGIN_ALLOW_THREADS
+        status = pm_fill_random_bytes(view.buf, (size_t)view.len);
+        if (status == 0)
+        {
+            uint8_t* data = (uint8_t*)view.buf;
+            Py_ssize_t count = view.len / item.size;
+            if (item.code == 'd')
+            {
+                for (Py_ssize_t i = 0; i < count; ++i)
+                {
+                    uint64_t word;
+                    memcpy(&word, data + i * 8, 8);
+                    double value = (double)(word >> 11) * (1.0 / 9007199254740992.0);
+                    memcpy(data + i * 8, &value, 8);
+                }
+            }
+            else
+            {
+                for (Py_ssize_t i = 0; i < count; ++i)
+                {
+                    uint32_t word;
+                    memcpy(&word, data + i * 4, 4);
+                    float value = (float)(word >> 8) * (1.0f / 16777216.0f);
+                    memcpy(data + i * 4, &value, 4);
+                }
+            }
+        }
+        Py_END_ALLOW_THREADS
+    }
+    PyBuffer_Release(&view);
+
+    if (status != 0)
+        return pm_py_device_error(status);
+    Py_RETURN_NONE;
+}
+
+///
+/// @brief random_bytes(n) - returns n random bytes.
+///
+static PyObject* pm_py_random_bytes(PyObject* self, PyObject* args)
+{
+    (void)self;
+    Py_ssize_t length;
+    if (!PyArg_ParseTuple(args, "n:random_bytes", &length))
+        return NULL;
+    if (length < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "length must be non-negative");
+        return NULL;
+    }
+
+    PyObject* result = PyBytes_FromStringAndSize(NULL, length);
+    if (result == NULL || length == 0)
+        return result;
+
+    int status;
+    char* data = PyBytes_AS_STRING(result);
+    Py_BEGIN_ALLOW_THREADS
+    status = pm_fill_random_bytes(data, (size_t)length);
+    Py_END_ALLOW_THREADS
+
+    if (status != 0)
+    {
+        Py_DECREF(result);
+        return pm_py_device_error(status);
+    }
+    return result;
+}
+
+///
+/// @brief guid() - returns a version 4 GUID string.
+///
+static PyObject* pm_py_guid(PyObject* self, PyObject* args)
+{
+    (void)self;
+    (void)args;
+    char text[37] = { 0 };
+    char* buffer = text;
+    int status = pm_get_guid_std(&buffer);
+    if (status != 0)
+        return pm_py_device_error(status);
+    return PyUnicode_FromStringAndSize(text, 36);
+}
+
+///
+/// @brief license_key(signature) - returns a license key matching the signature.
+///
+static PyObject* pm_py_license_key(PyObject* self, PyObject* args)
+{
+    (void)self;
+    int signature;
+    if (!PyArg_ParseTuple(args, "i:license_key", &signature))
+        return NULL;
+
+    char* key = NULL;
+    int size = pm_get_license_key(&key, signature);
+    if (size < 0 || key == NULL)
+        return pm_py_device_error(size);
+
+    PyObject* result = PyUnicode_FromString(key);
+    pm_free(key, size);
+    return result;
+}
+
+///
+/// @brief validate_license_key(key, signature) - checks the key's digit-sum signature.
+///
+static PyObject* pm_py_validate_license_key(PyObject* self, PyObject* args)
+{
+    (void)self;
+    const char* key;
+    int signature;
+    if (!PyArg_ParseTuple(args, "si:validate_license_key", &key, &signature))
+        return NULL;
+    return PyBool_FromLong(pm_validate_license_key(key, signature));
+}
+
+static PyMethodDef pm_py_methods[] = {
+    { "fill_bytes", pm_py_fill_bytes, METH_VARARGS,
+      "fill_bytes(buffer)\n\nFill a writable contiguous buffer with random bytes in place." },
+    { "fill_integers", pm_py_fill_integers, METH_VARARGS,
+      "fill_integers(buffer, low, high)\n\nFill an integer buffer in place with unbiased values in [low, high]." },
+    { "fill_doubles", pm_py_fill_doubles, METH_VARARGS,
+      "fill_doubles(buffer)\n\nFill a float32/float64 buffer in place with values in [0, 1)." },
+    { "random_bytes", pm_py_random_bytes, METH_VARARGS,
+      "random_bytes(n)\n\nReturn n random bytes." },
+    { "guid", pm_py_guid, METH_NOARGS,
+      "guid()\n\nReturn a version 4 GUID string." },
+    { "license_key", pm_py_license_key, METH_VARARGS,
+      "license_key(signature)\n\nReturn a license key matching the signature." },
+    { "validate_license_key", pm_py_validate_license_key, METH_VARARGS,
+      "validate_license_key(key, signature)\n\nCheck the digit-sum signature of a key." },
+    { NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef pm_py_module = {
+    PyModuleDef_HEAD_INIT,
+    "prng_mini",
+    "PRNG_mini bindings. Bulk fills write in place into buffer-protocol objects\n"
+    "(bytearray, memoryview, numpy.ndarray) and run without the GIL.",
+    -1,
+    pm_py_methods,
+    NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit_prng_mini(void)
+{
+    return PyModule_Create(&pm_py_module);
+}
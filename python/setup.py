@@ -0,0 +1,54 @@
+import os
+import shutil
+import sys
+
+from setuptools import Extension, setup
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+REPO_ROOT = os.path.dirname(HERE)
+
+# The library's C sources live outside this package. Building from the repository
+# copies them into csrc/, which MANIFEST.in ships in sdists, so builds from an
+# sdist or an isolated build directory find them without the repository.
+VENDOR_DIR = "csrc"
+C_SOURCES = ["PRNG_mini.c", "fill_file.c"]
+C_HEADERS = ["PRNG_mini.h"]
+
+
+def vendor_c_sources():
+    src_dir = os.path.join(REPO_ROOT, "src")
+    include_dir = os.path.join(REPO_ROOT, "include")
+    if not all(os.path.isfile(os.path.join(src_dir, name)) for name in C_SOURCES):
+        return  # building from an sdist: csrc/ is already in place
+
+    target = os.path.join(HERE, VENDOR_DIR)
+    os.makedirs(target, exist_ok=True)
+    for name in C_SOURCES:
+        shutil.copy2(os.path.join(src_dir, name), os.path.join(target, name))
+    for name in C_HEADERS:
+        shutil.copy2(os.path.join(include_dir, name), os.path.join(target, name))
+
+
+vendor_c_sources()
+
+libraries = ["bcrypt"] if sys.platform == "win32" else []
+extra_compile_args = [] if sys.platform == "win32" else ["-O3", "-pthread"]
+extra_link_args = [] if sys.platform == "win32" else ["-pthread"]
+
+setup(
+    name="prng_mini",
+    version="0.1",
+    description="Python bindings for the PRNG_mini C library",
+    license="GPL-3.0-only",
+    ext_modules=[
+        Extension(
+            "prng_mini",
+            sources=["prng_mini_module.c"] + [VENDOR_DIR + "/" + name for name in C_SOURCES],
+            include_dirs=[VENDOR_DIR],
+            define_macros=[("_CRT_SECURE_NO_WARNINGS", None)],
+            libraries=libraries,
+            extra_compile_args=extra_compile_args,
+            extra_link_args=extra_link_args,
+        )
+    ],
+)
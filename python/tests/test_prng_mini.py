@@ -0,0 +1,104 @@
+import array
+import threading
+
+import pytest
+
+import prng_mini
+
+
+def test_fill_bytes_bytearray_in_place():
+    buffer = bytearray(4096)
+    prng_mini.fill_bytes(buffer)
+    assert len(buffer) == 4096
+    assert any(buffer)
+
+
+def test_fill_bytes_memoryview_slice():
+    buffer = bytearray(64)
+    prng_mini.fill_bytes(memoryview(buffer)[16:32])
+    assert buffer[:16] == bytes(16)
+    assert buffer[32:] == bytes(32)
+
+
+def test_fill_bytes_rejects_readonly():
+    with pytest.raises(BufferError):
+        prng_mini.fill_bytes(b"immutable")
+
+
+@pytest.mark.parametrize("typecode", ["b", "B", "h", "H", "i", "I", "l", "L", "q", "Q"])
+def test_fill_integers_bounds(typecode):
+    values = array.array(typecode, bytes(array.array(typecode).itemsize * 2000))
+    low, high = (-3, 3) if typecode.islower() else (10, 16)
+    prng_mini.fill_integers(values, low, high)
+    assert min(values) == low
+    assert max(values) == high
+
+
+def test_fill_integers_full_range():
+    values = array.array("Q", bytes(8 * 64))
+    prng_mini.fill_integers(values, 0, 2**64 - 1)
+    assert len(set(values)) > 60
+
+
+def test_fill_integers_uniform():
+    values = array.array("i", bytes(4 * 60000))
+    prng_mini.fill_integers(values, 0, 5)
+    counts = [values.count(v) for v in range(6)]
+    assert all(9000 < c < 11000 for c in counts)
+
+
+def test_fill_integers_invalid_bounds():
+    values = array.array("B", bytes(8))
+    with pytest.raises(ValueError):
+        prng_mini.fill_integers(values, 0, 256)
+    with pytest.raises(ValueError):
+        prng_mini.fill_integers(values, 5, 1)
+    with pytest.raises(TypeError):
+        prng_mini.fill_integers(array.array("d", [0.0]), 0, 1)
+
+
+@pytest.mark.parametrize("typecode", ["f", "d"])
+def test_fill_doubles_unit_interval(typecode):
+    values = array.array(typecode, [2.0] * 10000)
+    prng_mini.fill_doubles(values)
+    assert all(0.0 <= v < 1.0 for v in values)
+    assert 0.45 < sum(values) / len(values) < 0.55
+
+
+def test_gil_released_threads():
+    buffers = [bytearray(1 << 20) for _ in range(4)]
+    threads = [threading.Thread(target=prng_mini.fill_bytes, args=(b,)) for b in buffers]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert all(any(b) for b in buffers)
+
+
+def test_helpers():
+    assert len(prng_mini.random_bytes(32)) == 32
+    guid = prng_mini.guid()
+    assert len(guid) == 36 and guid[14] == "4"
+    assert len(prng_mini.license_key(210)) == 19
+
+
+def test_numpy_zero_copy():
+    np = pytest.importorskip("numpy")
+
+    data = np.zeros(100000, dtype=np.int64)
+    address = data.ctypes.data
+    prng_mini.fill_integers(data, -1000, 1000)
+    assert data.ctypes.data == address
+    assert data.min() == -1000 and data.max() == 1000
+
+    samples = np.empty((256, 256), dtype=np.float64)
+    prng_mini.fill_doubles(samples)
+    assert 0.0 <= samples.min() and samples.max() < 1.0
+
+    raw = np.zeros(1024, dtype=np.uint8)
+    prng_mini.fill_bytes(raw)
+    assert raw.any()
+
+    column = np.zeros((8, 8), dtype=np.int32)[:, 0]
+    with pytest.raises((BufferError, ValueError)):
+        prng_mini.fill_integers(column, 0, 1)
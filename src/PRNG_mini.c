@@ -1,6 +1,7 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <limits.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -10,34 +11,56 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
 #endif
 
+// Largest single device request; bigger fills are split into chunks of this size.
+#define PM_DEVICE_CHUNK_SIZE ((size_t)1 << 30)
+
+// Buffers at least this large are mapped directly and advised to use huge pages.
+#define PM_LARGE_BUFFER_THRESHOLD ((size_t)2 << 20)
+
 #ifdef _WIN32
 ///
 /// @brief PRNG mini - device based - random bytes generation for Windows
 /// @details Fill the provided buffer with cryptographically secure random bytes.
+///          Requests larger than PM_DEVICE_CHUNK_SIZE are split, since BCryptGenRandom takes a ULONG.
 /// @param buffer Pointer to memory where random bytes will be written.
 /// @param length Number of bytes to generate.
 /// @return 0 on success, non-zero error code on failure.
 ///
-int pm_random_device_bytes_windows(void* buffer, int length)
+int pm_random_device_bytes_windows(void* buffer, size_t length)
 {
     if (!buffer || length == 0)
         return -1; // invalid arguments
 
-    NTSTATUS status = BCryptGenRandom(
-        NULL,                           // Use system-preferred RNG
-        (PUCHAR)buffer,
-        (ULONG)length,
-        BCRYPT_USE_SYSTEM_PREFERRED_RNG
-    );
+    unsigned char* output = (unsigned char*)buffer;
+    while (length > 0)
+    {
+        size_t chunk = length < PM_DEVICE_CHUNK_SIZE ? length : PM_DEVICE_CHUNK_SIZE;
+
+        NTSTATUS status = BCryptGenRandom(
+            NULL,                           // Use system-preferred RNG
+            (PUCHAR)output,
+            (ULONG)chunk,
+            BCRYPT_USE_SYSTEM_PREFERRED_RNG
+        );
+        if (status != 0)
+            return (int)status;
+
+        output += chunk;
+        length -= chunk;
+    }
 
-    return (status == 0) ? 0 : (int)status;
+    return 0;
 }
 #else
 ///
 /// @brief PRNG mini - device based - random bytes generation for Unix
 /// @details Fills the given buffer with cryptographically secure random bytes using /dev/urandom.
+///          Reads are issued in chunks of at most PM_DEVICE_CHUNK_SIZE and short or
+///          interrupted reads are resumed, so any size_t length can be served.
 /// @param buffer Pointer to the memory where random bytes will be written.
 /// @param length Number of bytes to generate.
 /// @return 0 on success,
@@ -50,13 +73,30 @@ int pm_random_device_bytes_unix(void* buffer, size_t length)
     if (!buffer || length == 0)
         return -1;
 
-    int fd = open("/dev/urandom", O_RDONLY);
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
     if (fd < 0)
         return -2;
 
-    ssize_t result = read(fd, buffer, length);
+    unsigned char* output = (unsigned char*)buffer;
+    while (length > 0)
+    {
+        size_t chunk = length < PM_DEVICE_CHUNK_SIZE ? length : PM_DEVICE_CHUNK_SIZE;
+
+        ssize_t result = read(fd, output, chunk);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+        {
+            close(fd);
+            return -3;
+        }
+
+        output += result;
+        length -= (size_t)result;
+    }
+
     close(fd);
-    return (result == (ssize_t)length) ? 0 : -3;
+    return 0;
 }
 #endif
 
@@ -78,6 +118,69 @@ void pm_free(void* buffer, int size)
     free(buffer);
 }
 
+///
+/// @brief Allocates a buffer suited for large random fills.
+/// @details Buffers of at least PM_LARGE_BUFFER_THRESHOLD bytes are mapped directly and,
+///          where supported, advised to use transparent huge pages. Smaller buffers use malloc.
+///          Release with pm_free_large() passing the same length.
+/// @param length Number of bytes to allocate.
+/// @return Pointer to the allocation, NULL on failure.
+///
+void* pm_alloc_large(size_t length)
+{
+    if (length == 0)
+        return NULL;
+
+#ifdef _WIN32
+    if (length >= PM_LARGE_BUFFER_THRESHOLD)
+        return VirtualAlloc(NULL, length, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+    if (length >= PM_LARGE_BUFFER_THRESHOLD)
+    {
+        void* mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED)
+            return NULL;
+#ifdef MADV_HUGEPAGE
+        madvise(mapping, length, MADV_HUGEPAGE); // advisory only, failure is harmless
+#endif
+        return mapping;
+    }
+#endif
+
+    return malloc(length);
+}
+
+///
+/// @brief Safe zeroization and release of a buffer from pm_alloc_large()
+/// @param buffer Pointer returned by pm_alloc_large() or pm_get_random_bytes_large().
+/// @param length Length passed at allocation time; the whole buffer is zeroized.
+///
+void pm_free_large(void* buffer, size_t length)
+{
+    if (buffer == NULL)
+        return;
+
+    volatile unsigned char* wipe = (volatile unsigned char*)buffer;
+    for (size_t i = 0; i < length; ++i)
+        wipe[i] = 0;
+
+#ifdef _WIN32
+    if (length >= PM_LARGE_BUFFER_THRESHOLD)
+    {
+        VirtualFree(buffer, 0, MEM_RELEASE);
+        return;
+    }
+#else
+    if (length >= PM_LARGE_BUFFER_THRESHOLD)
+    {
+        munmap(buffer, length);
+        return;
+    }
+#endif
+
+    free(buffer);
+}
+
 ///
 /// @brief PRNG mini - device based - random bytes generation
 /// @details Fill the provided buffer with cryptographically secure random bytes.
@@ -120,6 +223,68 @@ int pm_get_random_bytes(void** buffer, int length)
     return result;
 }
 
+///
+/// @brief PRNG mini - device based - in-place random bytes generation
+/// @details Fills caller-owned memory with cryptographically secure random bytes.
+///          Unlike pm_get_random_bytes() the buffer is never allocated or released here.
+/// Usage: uint8_t buffer[64]; pm_fill_random_bytes(buffer, sizeof(buffer));
+/// @param buffer Pointer to memory where random bytes will be written.
+/// @param length Number of bytes to generate.
+/// @return 0 on success,
+///         non-zero error code on failure.
+///         -1 - invalid arguments.
+///         status < -1 - same device error codes as pm_get_random_bytes().
+///
+int pm_fill_random_bytes(void* buffer, size_t length)
+{
+    if (buffer == NULL || length == 0)
+        return -1;
+
+#ifdef _WIN32
+    return pm_random_device_bytes_windows(buffer, length);
+#else
+    return pm_random_device_bytes_unix(buffer, length);
+#endif
+}
+
+///
+/// @brief PRNG mini - device based - 64-bit length random bytes generation
+/// @details Same contract as pm_get_random_bytes() without the 2 GiB cap.
+///          A NULL *buffer is allocated with pm_alloc_large() and must be released
+///          with pm_free_large(); it is released on failure and *buffer is reset to NULL.
+///          A non-NULL *buffer is filled in place and never released here.
+/// @param buffer Pointer to memory of Pointer to memory where random bytes will be written.
+/// @param length Number of bytes to generate.
+/// @return 0 on success,
+///         non-zero error code on failure.
+///         -1 - invalid arguments.
+///         -2 - memory allocation failed.
+///         status < -1 - same device error codes as pm_get_random_bytes().
+///
+int pm_get_random_bytes_large(void** buffer, size_t length)
+{
+    if (buffer == NULL || length == 0)
+        return -1;
+
+    int allocated = 0;
+    if (*buffer == NULL)
+    {
+        *buffer = pm_alloc_large(length);
+        if (*buffer == NULL)
+            return -2; // memory allocation failed
+        allocated = 1;
+    }
+
+    int result = pm_fill_random_bytes(*buffer, length);
+    if (result != 0 && allocated)
+    {
+        pm_free_large(*buffer, length);
+        *buffer = NULL;
+    }
+
+    return result;
+}
+
 ///
 /// @brief PRNG mini - device based - random integers generation
 /// @details Fill the provided buffer with cryptographically secure random bytes.
@@ -148,7 +313,7 @@ int pm_get_random_integers(int** integers, int size, int min, int max)
     int byte_len = sizeof(uint32_t) * size; // 4 bytes per integer (uint32_t)
     unsigned char* byte_buffer = NULL;
 
-    int result = pm_get_random_bytes(&byte_buffer, byte_len);
+    int result = pm_get_random_bytes((void**)&byte_buffer, byte_len);
     if (result != 0 || byte_buffer == NULL)
         return -3; // random byte generation failed
 
@@ -184,7 +349,7 @@ int pm_get_random_int(int min, int max)
     // Allocate temporary random bytes buffer
     int byte_len = sizeof(int); 
     unsigned char* byte_buffer = NULL;
-    int result = pm_get_random_bytes(&byte_buffer, byte_len);
+    int result = pm_get_random_bytes((void**)&byte_buffer, byte_len);
     if (result != 0 || byte_buffer == NULL)
         return -3; // random byte generation failed
 
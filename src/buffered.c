@@ -0,0 +1,495 @@
+#include <PRNG_mini.h>
+
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+//Supported by Linux, MacOS, BSD, Android, iOS, Unix-Like OS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Per-CPU slots need restartable sequences: Linux x86_64 with glibc 2.35+ registration.
+#if defined(__linux__) && defined(__x86_64__) && defined(__GNUC__) && defined(__has_include)
+#if __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define PM_HAVE_RSEQ 1
+#endif
+#endif
+
+// Bytes of device output held by each slot.
+#define PM_BUFFER_SIZE 4096
+
+// Signature the kernel checks in the four bytes preceding an rseq abort handler.
+#define PM_RSEQ_SIG 0x53053053
+
+// Cache line alignment; MSVC only accepts _Alignas in C11 mode.
+#ifdef _MSC_VER
+#define PM_ALIGN(n) __declspec(align(n))
+#else
+#define PM_ALIGN(n) _Alignas(n)
+#endif
+
+// Pastes a macro's value into inline assembly text.
+#define PM_STRINGIFY_VALUE(x) #x
+#define PM_STRINGIFY(x) PM_STRINGIFY_VALUE(x)
+
+///
+/// @brief One buffer of device output.
+/// @details position counts consumed bytes; PM_BUFFER_SIZE means the slot is empty.
+///          Slots are cache-line aligned so per-CPU slots never share a line.
+///
+typedef struct
+{
+    PM_ALIGN(64) uint64_t position;
+#ifdef _WIN32
+    SRWLOCK refill_lock;
+#else
+    pthread_mutex_t refill_lock;
+#endif
+    PM_ALIGN(64) uint8_t buffer[PM_BUFFER_SIZE];
+} pm_buffer_slot;
+
+static volatile int pm_buffer_mode_current = PM_BUFFER_THREAD_LOCAL;
+
+static pm_buffer_slot pm_global_slot;
+static pm_buffer_slot* pm_cpu_slots = NULL;
+static unsigned int pm_cpu_slot_count = 0;
+
+#ifdef _WIN32
+static INIT_ONCE pm_buffer_once = INIT_ONCE_STATIC_INIT;
+static DWORD pm_thread_slot_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_once_t pm_buffer_once = PTHREAD_ONCE_INIT;
+static pthread_key_t pm_thread_slot_key;
+static int pm_thread_slot_key_valid = 0;
+#endif
+
+static void pm_slot_lock(pm_buffer_slot* slot)
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&slot->refill_lock);
+#else
+    pthread_mutex_lock(&slot->refill_lock);
+#endif
+}
+
+static void pm_slot_unlock(pm_buffer_slot* slot)
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&slot->refill_lock);
+#else
+    pthread_mutex_unlock(&slot->refill_lock);
+#endif
+}
+
+static void pm_slot_init(pm_buffer_slot* slot)
+{
+    memset(slot, 0, sizeof(*slot));
+    slot->position = PM_BUFFER_SIZE;
+#ifdef _WIN32
+    InitializeSRWLock(&slot->refill_lock);
+#else
+    pthread_mutex_init(&slot->refill_lock, NULL);
+#endif
+}
+
+///
+/// @brief Wipes a slot's buffered bytes and marks it empty.
+///
+static void pm_slot_discard(pm_buffer_slot* slot)
+{
+    volatile uint8_t* wipe = (volatile uint8_t*)slot->buffer;
+    for (size_t i = 0; i < PM_BUFFER_SIZE; ++i)
+        wipe[i] = 0;
+    slot->position = PM_BUFFER_SIZE;
+}
+
+///
+/// @brief Releases a thread's slot when the thread exits.
+///
+#ifdef _WIN32
+static void WINAPI pm_thread_slot_release(void* slot)
+#else
+static void pm_thread_slot_release(void* slot)
+#endif
+{
+    if (slot == NULL)
+        return;
+
+#ifndef _WIN32
+    pthread_mutex_destroy(&((pm_buffer_slot*)slot)->refill_lock);
+#endif
+
+    volatile uint8_t* wipe = (volatile uint8_t*)slot;
+    for (size_t i = 0; i < sizeof(pm_buffer_slot); ++i)
+        wipe[i] = 0;
+
+#ifdef _WIN32
+    _aligned_free(slot);
+#else
+    free(slot);
+#endif
+}
+
+///
+/// @brief One-time setup: global slot, per-thread key and per-CPU slots.
+///
+#ifdef _WIN32
+static BOOL CALLBACK pm_buffer_init(PINIT_ONCE once, PVOID parameter, PVOID* context)
+{
+    (void)once;
+    (void)parameter;
+    (void)context;
+    pm_slot_init(&pm_global_slot);
+    pm_thread_slot_key = FlsAlloc(pm_thread_slot_release);
+    return TRUE;
+}
+#else
+///
+/// @brief Holds every shared slot's lock across fork(), so the child never inherits
+///        a slot in the middle of a refill.
+///
+static void pm_buffer_before_fork(void)
+{
+    pm_slot_lock(&pm_global_slot);
+    for (unsigned int i = 0; i < pm_cpu_slot_count; ++i)
+        pm_slot_lock(&pm_cpu_slots[i]);
+}
+
+static void pm_buffer_after_fork_parent(void)
+{
+    for (unsigned int i = pm_cpu_slot_count; i > 0; --i)
+        pm_slot_unlock(&pm_cpu_slots[i - 1]);
+    pm_slot_unlock(&pm_global_slot);
+}
+
+///
+/// @brief Discards every buffer the child inherited, so parent and child never
+///        hand out the same words. Slots of the parent's other threads are
+///        unreachable in the child and stay unused.
+///
+static void pm_buffer_after_fork_child(void)
+{
+    pm_slot_discard(&pm_global_slot);
+    for (unsigned int i = 0; i < pm_cpu_slot_count; ++i)
+        pm_slot_discard(&pm_cpu_slots[i]);
+
+    if (pm_thread_slot_key_valid)
+    {
+        pm_buffer_slot* slot = (pm_buffer_slot*)pthread_getspecific(pm_thread_slot_key);
+        if (slot != NULL)
+            pm_slot_discard(slot);
+    }
+
+    pm_buffer_after_fork_parent();
+}
+
+static void pm_buffer_init(void)
+{
+    pm_slot_init(&pm_global_slot);
+    pm_thread_slot_key_valid = pthread_key_create(&pm_thread_slot_key, pm_thread_slot_release) == 0;
+
+#ifdef PM_HAVE_RSEQ
+    long count = sysconf(_SC_NPROCESSORS_CONF);
+    if (__rseq_size > 0 && count > 0)
+    {
+        void* slots = NULL;
+        if (posix_memalign(&slots, 64, (size_t)count * sizeof(pm_buffer_slot)) == 0)
+        {
+            pm_cpu_slots = (pm_buffer_slot*)slots;
+            for (long i = 0; i < count; ++i)
+                pm_slot_init(&pm_cpu_slots[i]);
+            pm_cpu_slot_count = (unsigned int)count;
+        }
+    }
+#endif
+
+    pthread_atfork(pm_buffer_before_fork, pm_buffer_after_fork_parent, pm_buffer_after_fork_child);
+}
+#endif
+
+static void pm_buffer_ensure_init(void)
+{
+#ifdef _WIN32
+    InitOnceExecuteOnce(&pm_buffer_once, pm_buffer_init, NULL, NULL);
+#else
+    pthread_once(&pm_buffer_once, pm_buffer_init);
+#endif
+}
+
+///
+/// @brief Takes the next word from a slot the caller has exclusive access to.
+/// @details The consumed word is wiped from the buffer.
+/// @return 0 on success, device error code on refill failure.
+///
+static int pm_slot_take_exclusive(pm_buffer_slot* slot, uint64_t* value)
+{
+    if (slot->position > PM_BUFFER_SIZE - sizeof(uint64_t))
+    {
+        int status = pm_fill_random_bytes(slot->buffer, PM_BUFFER_SIZE);
+        if (status != 0)
+            return status;
+        slot->position = 0;
+    }
+
+    memcpy(value, slot->buffer + slot->position, sizeof(uint64_t));
+    memset(slot->buffer + slot->position, 0, sizeof(uint64_t));
+    slot->position += sizeof(uint64_t);
+    return 0;
+}
+
+static pm_buffer_slot* pm_thread_slot(void)
+{
+    pm_buffer_slot* slot;
+
+#ifdef _WIN32
+    if (pm_thread_slot_key == FLS_OUT_OF_INDEXES)
+        return NULL;
+    slot = (pm_buffer_slot*)FlsGetValue(pm_thread_slot_key);
+    if (slot != NULL)
+        return slot;
+    slot = (pm_buffer_slot*)_aligned_malloc(sizeof(pm_buffer_slot), 64);
+    if (slot == NULL)
+        return NULL;
+    pm_slot_init(slot);
+    FlsSetValue(pm_thread_slot_key, slot);
+#else
+    if (!pm_thread_slot_key_valid)
+        return NULL;
+    slot = (pm_buffer_slot*)pthread_getspecific(pm_thread_slot_key);
+    if (slot != NULL)
+        return slot;
+    void* memory = NULL;
+    if (posix_memalign(&memory, 64, sizeof(pm_buffer_slot)) != 0)
+        return NULL;
+    slot = (pm_buffer_slot*)memory;
+    pm_slot_init(slot);
+    pthread_setspecific(pm_thread_slot_key, slot);
+#endif
+
+    return slot;
+}
+
+static int pm_thread_local_u64(uint64_t* value)
+{
+    pm_buffer_slot* slot = pm_thread_slot();
+    if (slot == NULL)
+        return -2;
+    return pm_slot_take_exclusive(slot, value);
+}
+
+static int pm_global_locked_u64(uint64_t* value)
+{
+    pm_slot_lock(&pm_global_slot);
+    int status = pm_slot_take_exclusive(&pm_global_slot, value);
+    pm_slot_unlock(&pm_global_slot);
+    return status;
+}
+
+#ifdef PM_HAVE_RSEQ
+static struct rseq* pm_rseq_area(void)
+{
+    return (struct rseq*)((char*)__builtin_thread_pointer() + __rseq_offset);
+}
+
+///
+/// @brief Pops the next word from the current CPU's slot inside a restartable sequence.
+/// @details The sequence checks that the thread still runs on `cpu`, that the slot holds
+///          a whole word, loads it and commits by storing the new position. Preemption,
+///          migration or a signal before the commit store restarts at the abort handler,
+///          so the slot needs no atomics or locks. Consumed words cannot be wiped here,
+///          because no store may follow the commit; they are overwritten on refill.
+/// @return 0 on success, 1 if the slot is empty, -1 if the sequence was aborted.
+///
+static inline int pm_rseq_pop(struct rseq* rs, pm_buffer_slot* slot, uint32_t cpu, uint64_t* value)
+{
+    int result;
+    uint64_t word;
+
+    __asm__ __volatile__(
+        ".pushsection __rseq_cs, \"aw\"\n\t"
+        ".balign 32\n\t"
+        "3:\n\t"
+        ".long 0, 0\n\t"                            // version, flags
+        ".quad 1f, (2f - 1f), 4f\n\t"               // start_ip, post_commit_offset, abort_ip
+        ".popsection\n\t"
+        "leaq 3b(%%rip), %%rax\n\t"
+        "movq %%rax, %[rseq_cs]\n\t"
+        "1:\n\t"
+        "cmpl %[cpu], %[cpu_id]\n\t"
+        "jnz 4f\n\t"
+        "movq %[position], %%rcx\n\t"
+        "cmpq %[last], %%rcx\n\t"
+        "ja 5f\n\t"
+        "movq (%[buffer], %%rcx), %[word]\n\t"
+        "addq $8, %%rcx\n\t"
+        "movq %%rcx, %[position]\n\t"               // commit
+        "2:\n\t"
+        "xorl %[result], %[result]\n\t"
+        "jmp 6f\n\t"
+        ".pushsection __rseq_failure, \"ax\"\n\t"
+        ".byte 0x0f, 0xb9, 0x3d\n\t"                // ud1 carrying the signature
+        ".long " PM_STRINGIFY(PM_RSEQ_SIG) "\n\t"
+        "4:\n\t"
+        "movl $-1, %[result]\n\t"
+        "jmp 6f\n\t"
+        ".popsection\n\t"
+        "5:\n\t"
+        "movl $1, %[result]\n\t"
+        "6:\n\t"
+        : [result] "=&r" (result),
+          [word] "=&r" (word),
+          [rseq_cs] "=m" (rs->rseq_cs),
+          [position] "+m" (slot->position)
+        : [cpu] "r" (cpu),
+          [cpu_id] "m" (rs->cpu_id),
+          [buffer] "r" (slot->buffer),
+          [last] "i" (PM_BUFFER_SIZE - sizeof(uint64_t))
+        : "rax", "rcx", "memory", "cc");
+
+    *value = word;
+    return result;
+}
+
+///
+/// @brief Refills an empty per-CPU slot.
+/// @details Runs on any CPU under the slot's lock. Threads on the slot's CPU see it empty
+///          and wait here, so the buffer is not read while it is rewritten; the new
+///          position is published with release ordering after the bytes.
+///
+static int pm_cpu_slot_refill(pm_buffer_slot* slot)
+{
+    int status = 0;
+
+    pm_slot_lock(slot);
+    if (__atomic_load_n(&slot->position, __ATOMIC_RELAXED) > PM_BUFFER_SIZE - sizeof(uint64_t))
+    {
+        status = pm_fill_random_bytes(slot->buffer, PM_BUFFER_SIZE);
+        if (status == 0)
+            __atomic_store_n(&slot->position, 0, __ATOMIC_RELEASE);
+    }
+    pm_slot_unlock(slot);
+
+    return status;
+}
+
+static int pm_per_cpu_u64(uint64_t* value)
+{
+    struct rseq* rs = pm_rseq_area();
+
+    for (;;)
+    {
+        uint32_t cpu = __atomic_load_n(&rs->cpu_id_start, __ATOMIC_RELAXED);
+        if (cpu >= pm_cpu_slot_count)
+            return pm_thread_local_u64(value);
+
+        pm_buffer_slot* slot = &pm_cpu_slots[cpu];
+        int result = pm_rseq_pop(rs, slot, cpu, value);
+        if (result == 0)
+            return 0;
+
+        if (result > 0)
+        {
+            int status = pm_cpu_slot_refill(slot);
+            if (status != 0)
+                return status;
+        }
+    }
+}
+#endif
+
+///
+/// @brief Selects how the buffered generator keeps its state.
+/// @details PM_BUFFER_PER_CPU needs restartable sequences (Linux x86_64, glibc 2.35+);
+///          elsewhere it falls back to PM_BUFFER_THREAD_LOCAL.
+/// @param mode One of pm_buffer_mode.
+/// @return The mode now in effect, -1 for an unknown mode.
+///
+int pm_buffered_set_mode(int mode)
+{
+    if (mode != PM_BUFFER_THREAD_LOCAL && mode != PM_BUFFER_GLOBAL_LOCKED && mode != PM_BUFFER_PER_CPU)
+        return -1;
+
+    pm_buffer_ensure_init();
+
+    if (mode == PM_BUFFER_PER_CPU && pm_cpu_slot_count == 0)
+        mode = PM_BUFFER_THREAD_LOCAL;
+
+    pm_buffer_mode_current = mode;
+    return mode;
+}
+
+///
+/// @brief Returns the mode in effect for the buffered generator.
+///
+int pm_buffered_get_mode(void)
+{
+    return pm_buffer_mode_current;
+}
+
+///
+/// @brief PRNG mini - buffered - random 64-bit word
+/// @details Serves words from a 4 KiB buffer of device output instead of a device
+///          read per call. Thread-safe in every mode; a child process discards the
+///          buffers it inherits through fork().
+/// @param value Output word.
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         -2 - per-thread state allocation failed.
+///         other negative - device error codes as pm_fill_random_bytes().
+///
+int pm_buffered_u64(uint64_t* value)
+{
+    if (value == NULL)
+        return -1;
+
+    pm_buffer_ensure_init();
+
+    switch (pm_buffer_mode_current)
+    {
+    case PM_BUFFER_GLOBAL_LOCKED:
+        return pm_global_locked_u64(value);
+#ifdef PM_HAVE_RSEQ
+    case PM_BUFFER_PER_CPU:
+        return pm_per_cpu_u64(value);
+#endif
+    default:
+        return pm_thread_local_u64(value);
+    }
+}
+
+///
+/// @brief PRNG mini - buffered - random bytes generation
+/// @details Small requests are served from the buffered generator; requests of a
+///          buffer size or more go straight to the device.
+/// @param buffer Pointer to memory where random bytes will be written.
+/// @param length Number of bytes to generate.
+/// @return Same error codes as pm_buffered_u64().
+///
+int pm_buffered_bytes(void* buffer, size_t length)
+{
+    if (buffer == NULL)
+        return -1;
+    if (length >= PM_BUFFER_SIZE)
+        return pm_fill_random_bytes(buffer, length);
+
+    uint8_t* output = (uint8_t*)buffer;
+    while (length > 0)
+    {
+        uint64_t word;
+        int status = pm_buffered_u64(&word);
+        if (status != 0)
+            return status;
+
+        size_t chunk = length < sizeof(word) ? length : sizeof(word);
+        memcpy(output, &word, chunk);
+        output += chunk;
+        length -= chunk;
+    }
+
+    return 0;
+}
@@ -0,0 +1,269 @@
+#include <PRNG_mini.h>
+
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+//Supported by Linux, MacOS, BSD, Android, iOS, Unix-Like OS
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#endif
+
+// Size of each of the two stage buffers.
+#define PM_FILL_BUFFER_SIZE ((size_t)8 << 20)
+
+///
+/// @brief Writes a whole buffer to a descriptor.
+/// @details Resumes partial and interrupted writes.
+/// @return 0 on success, -5 if writing failed.
+///
+static int pm_write_all(int fd, const unsigned char* data, size_t length)
+{
+    while (length > 0)
+    {
+#ifdef _WIN32
+        unsigned int chunk = length < (1u << 30) ? (unsigned int)length : (1u << 30);
+        int result = _write(fd, data, chunk);
+        if (result <= 0)
+            return -5;
+#else
+        ssize_t result = write(fd, data, length);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            return -5;
+#endif
+        data += result;
+        length -= (size_t)result;
+    }
+
+    return 0;
+}
+
+#ifndef _WIN32
+///
+/// @brief State shared by the generate and write stages.
+/// @details The generator fills buffers[i] while the writer drains buffers[i ^ 1];
+///          ready[i] hands a buffer from one stage to the other.
+///
+typedef struct
+{
+    int fd;
+    unsigned char* buffers[2];
+    size_t lengths[2];
+    int ready[2];       // 1 while a buffer holds bytes waiting to be written
+    int finished;       // generator has no more buffers to hand over
+    int status;         // first error reported by either stage
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} pm_fill_pipeline;
+
+///
+/// @brief Write stage: drains buffers in order until the generator finishes.
+///
+static void* pm_fill_writer(void* argument)
+{
+    pm_fill_pipeline* pipeline = (pm_fill_pipeline*)argument;
+    int index = 0;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&pipeline->lock);
+        while (!pipeline->ready[index] && !pipeline->finished && pipeline->status == 0)
+            pthread_cond_wait(&pipeline->changed, &pipeline->lock);
+
+        if (!pipeline->ready[index] || pipeline->status != 0)
+        {
+            pthread_mutex_unlock(&pipeline->lock);
+            break;
+        }
+        size_t length = pipeline->lengths[index];
+        pthread_mutex_unlock(&pipeline->lock);
+
+        int result = pm_write_all(pipeline->fd, pipeline->buffers[index], length);
+
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->ready[index] = 0;
+        if (result != 0 && pipeline->status == 0)
+            pipeline->status = result;
+        pthread_cond_broadcast(&pipeline->changed);
+        pthread_mutex_unlock(&pipeline->lock);
+
+        if (result != 0)
+            break;
+        index ^= 1;
+    }
+
+    return NULL;
+}
+
+///
+/// @brief Generate stage: fills buffers in order and hands them to the writer.
+///
+static void pm_fill_generator(pm_fill_pipeline* pipeline, uint64_t size, size_t buffer_size)
+{
+    uint64_t remaining = size;
+    int index = 0;
+
+    while (remaining > 0)
+    {
+        pthread_mutex_lock(&pipeline->lock);
+        while (pipeline->ready[index] && pipeline->status == 0)
+            pthread_cond_wait(&pipeline->changed, &pipeline->lock);
+        int status = pipeline->status;
+        pthread_mutex_unlock(&pipeline->lock);
+
+        if (status != 0)
+            return;
+
+        size_t chunk = remaining < buffer_size ? (size_t)remaining : buffer_size;
+        int result = pm_fill_random_bytes(pipeline->buffers[index], chunk);
+
+        pthread_mutex_lock(&pipeline->lock);
+        if (result != 0)
+        {
+            if (pipeline->status == 0)
+                pipeline->status = -3;
+        }
+        else
+        {
+            pipeline->lengths[index] = chunk;
+            pipeline->ready[index] = 1;
+        }
+        pthread_cond_broadcast(&pipeline->changed);
+        pthread_mutex_unlock(&pipeline->lock);
+
+        if (result != 0)
+            return;
+
+        remaining -= chunk;
+        index ^= 1;
+    }
+}
+#endif
+
+///
+/// @brief Streams random bytes into an open file descriptor.
+/// @details Same pipeline as pm_fill_file(); bytes are written at the current offset
+///          and the descriptor is left open.
+/// @param fd Descriptor opened for writing (a CRT descriptor on Windows).
+/// @param size Number of random bytes to write.
+/// @return Same error codes as pm_fill_file(), except -4.
+///
+int pm_fill_fd(int fd, uint64_t size)
+{
+    if (fd < 0)
+        return -1;
+    if (size == 0)
+        return 0;
+
+    size_t buffer_size = size < PM_FILL_BUFFER_SIZE ? (size_t)size : PM_FILL_BUFFER_SIZE;
+
+#ifdef _WIN32
+    // Serial fallback: generate, then write, one buffer at a time.
+    unsigned char* buffer = (unsigned char*)pm_alloc_large(buffer_size);
+    if (buffer == NULL)
+        return -2;
+
+    int status = 0;
+    uint64_t remaining = size;
+    while (remaining > 0 && status == 0)
+    {
+        size_t chunk = remaining < buffer_size ? (size_t)remaining : buffer_size;
+        if (pm_fill_random_bytes(buffer, chunk) != 0)
+            status = -3;
+        else
+            status = pm_write_all(fd, buffer, chunk);
+        remaining -= chunk;
+    }
+
+    pm_free_large(buffer, buffer_size);
+    return status;
+#else
+    pm_fill_pipeline pipeline;
+    memset(&pipeline, 0, sizeof(pipeline));
+    pipeline.fd = fd;
+
+    pipeline.buffers[0] = (unsigned char*)pm_alloc_large(buffer_size);
+    pipeline.buffers[1] = (unsigned char*)pm_alloc_large(buffer_size);
+    if (pipeline.buffers[0] == NULL || pipeline.buffers[1] == NULL)
+    {
+        pm_free_large(pipeline.buffers[0], buffer_size);
+        pm_free_large(pipeline.buffers[1], buffer_size);
+        return -2;
+    }
+
+    pthread_mutex_init(&pipeline.lock, NULL);
+    pthread_cond_init(&pipeline.changed, NULL);
+
+    pthread_t writer;
+    if (pthread_create(&writer, NULL, pm_fill_writer, &pipeline) != 0)
+    {
+        pipeline.status = -2;
+    }
+    else
+    {
+        pm_fill_generator(&pipeline, size, buffer_size);
+
+        pthread_mutex_lock(&pipeline.lock);
+        pipeline.finished = 1;
+        pthread_cond_broadcast(&pipeline.changed);
+        pthread_mutex_unlock(&pipeline.lock);
+
+        pthread_join(writer, NULL);
+    }
+
+    pthread_cond_destroy(&pipeline.changed);
+    pthread_mutex_destroy(&pipeline.lock);
+    pm_free_large(pipeline.buffers[0], buffer_size);
+    pm_free_large(pipeline.buffers[1], buffer_size);
+
+    return pipeline.status;
+#endif
+}
+
+///
+/// @brief Streams random bytes into a file.
+/// @details The file is created (mode 0600) or truncated. Generation and writing run
+///          as two overlapped stages over a pair of large buffers, so the device and the
+///          disk are kept busy at the same time. Buffers are zeroized before release.
+/// @param path Path of the output file.
+/// @param size Number of random bytes to write.
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments.
+///         -2 - memory allocation or thread creation failed.
+///         -3 - random bytes generation failed.
+///         -4 - the file could not be opened.
+///         -5 - writing to the file failed.
+///
+int pm_fill_file(const char* path, uint64_t size)
+{
+    if (path == NULL)
+        return -1;
+
+#ifdef _WIN32
+    int fd = _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+#endif
+    if (fd < 0)
+        return -4;
+
+    int status = pm_fill_fd(fd, size);
+
+#ifdef _WIN32
+    if (_close(fd) != 0 && status == 0)
+        status = -5;
+#else
+    if (close(fd) != 0 && status == 0)
+        status = -5;
+#endif
+
+    return status;
+}
@@ -0,0 +1,661 @@
+#include <PRNG_mini.h>
+
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+//Supported by Linux, MacOS, BSD, Android, iOS, Unix-Like OS
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// "PMKS" - identifies a serialized key set
+#define PM_KEYSET_MAGIC 0x534B4D50u
+#define PM_KEYSET_VERSION 1u
+
+// Symbols in a license key (dashes excluded) and bytes of a packed key.
+#define PM_KEY_SYMBOLS 16
+#define PM_KEY_PACKED_SIZE 11
+
+// Average number of keys per directory bucket.
+#define PM_KEYSET_BUCKET_LOAD 4
+
+// Keys looked up together in a batch before their memory is touched.
+#define PM_KEYSET_BATCH_GROUP 16
+
+///
+/// @brief Header of a key set image, shared by the in-memory and on-disk forms.
+/// @details The image is little-endian and laid out as:
+///          header | directory[(1 << directory_bits) + 1] (uint32) | records[key_count] (11 bytes)
+///          | Bloom filter (bloom_blocks x 64 bytes, 64-byte aligned).
+///          Records are grouped by the top directory_bits of their hash; directory[b]
+///          is the index of the first record of bucket b.
+///
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key_count;
+    uint32_t directory_bits;
+    uint32_t bloom_hashes;
+    uint64_t bloom_blocks;
+    uint64_t directory_offset;
+    uint64_t records_offset;
+    uint64_t bloom_offset;
+    uint64_t image_size;
+} pm_keyset_header;
+
+struct pm_keyset
+{
+    const uint8_t* image;
+    size_t image_size;
+    int mapped;             // 1 if image is a file mapping, 0 if heap memory
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+    const pm_keyset_header* header;
+    const uint32_t* directory;
+    const uint8_t* records;
+    const uint64_t* bloom;
+};
+
+///
+/// @brief Symbol value + 1 for 0-9, A-Z and a-z; PM_KEY_DASH for '-'; 0 for anything else.
+///
+#define PM_KEY_DASH 0xFF
+
+static const uint8_t pm_key_symbols[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6, ['6'] = 7, ['7'] = 8,
+    ['8'] = 9, ['9'] = 10,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16, ['G'] = 17, ['H'] = 18,
+    ['I'] = 19, ['J'] = 20, ['K'] = 21, ['L'] = 22, ['M'] = 23, ['N'] = 24, ['O'] = 25, ['P'] = 26,
+    ['Q'] = 27, ['R'] = 28, ['S'] = 29, ['T'] = 30, ['U'] = 31, ['V'] = 32, ['W'] = 33, ['X'] = 34,
+    ['Y'] = 35, ['Z'] = 36,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16, ['g'] = 17, ['h'] = 18,
+    ['i'] = 19, ['j'] = 20, ['k'] = 21, ['l'] = 22, ['m'] = 23, ['n'] = 24, ['o'] = 25, ['p'] = 26,
+    ['q'] = 27, ['r'] = 28, ['s'] = 29, ['t'] = 30, ['u'] = 31, ['v'] = 32, ['w'] = 33, ['x'] = 34,
+    ['y'] = 35, ['z'] = 36,
+    ['-'] = PM_KEY_DASH,
+};
+
+///
+/// @brief Packs a license key into 11 bytes.
+/// @details The 16 symbols (0-9, A-Z, case-insensitive; dashes ignored) are read as two
+///          base-36 numbers of 8 symbols, each below 36^8 < 2^42, and stored as one
+///          84-bit little-endian value.
+/// @return 0 on success, -1 if the key is malformed.
+///
+static int pm_keyset_pack(const char* key, uint8_t packed[PM_KEY_PACKED_SIZE])
+{
+    // Four groups of four symbols; independent groups keep the multiply chains short.
+    uint32_t groups[4] = { 0, 0, 0, 0 };
+    int symbols = 0;
+
+    for (const unsigned char* c = (const unsigned char*)key; *c != '\0'; ++c)
+    {
+        uint8_t symbol = pm_key_symbols[*c];
+        if (symbol == PM_KEY_DASH)
+            continue;
+        if (symbol == 0 || symbols == PM_KEY_SYMBOLS)
+            return -1;
+
+        groups[symbols >> 2] = groups[symbols >> 2] * 36 + (uint32_t)(symbol - 1);
+        symbols++;
+    }
+
+    if (symbols != PM_KEY_SYMBOLS)
+        return -1;
+
+    uint64_t first = (uint64_t)groups[0] * 1679616 + groups[1]; // 36^4
+    uint64_t second = (uint64_t)groups[2] * 1679616 + groups[3];
+    uint64_t low = first | (second << 42);
+    uint64_t high = second >> 22;
+    for (int i = 0; i < 8; ++i)
+        packed[i] = (uint8_t)(low >> (8 * i));
+    for (int i = 8; i < PM_KEY_PACKED_SIZE; ++i)
+        packed[i] = (uint8_t)(high >> (8 * (i - 8)));
+    return 0;
+}
+
+static uint64_t pm_keyset_mix(uint64_t value)
+{
+    // splitmix64 finalizer
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    return value;
+}
+
+static uint64_t pm_keyset_hash(const uint8_t packed[PM_KEY_PACKED_SIZE])
+{
+    uint64_t low = 0;
+    uint64_t high = 0;
+    for (int i = 0; i < 8; ++i)
+        low |= (uint64_t)packed[i] << (8 * i);
+    for (int i = 8; i < PM_KEY_PACKED_SIZE; ++i)
+        high |= (uint64_t)packed[i] << (8 * (i - 8));
+    return pm_keyset_mix(low ^ pm_keyset_mix(high + 0x9E3779B97F4A7C15ull));
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PM_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PM_PREFETCH(address) ((void)(address))
+#endif
+
+///
+/// @brief Picks a key's Bloom block from the low hash bits (multiply-shift, no division).
+///
+static size_t pm_keyset_bloom_block(uint64_t blocks, uint64_t hash)
+{
+    return (size_t)(((hash & 0xFFFFFFFFu) * blocks) >> 32);
+}
+
+///
+/// @brief Blocked Bloom filter: every probe of a key lands in one 64-byte block.
+///
+static void pm_keyset_bloom_add(uint64_t* bloom, uint64_t blocks, uint32_t hashes, uint64_t hash)
+{
+    uint64_t* block = bloom + pm_keyset_bloom_block(blocks, hash) * 8;
+    uint64_t probe = pm_keyset_mix(hash);
+    for (uint32_t i = 0; i < hashes; ++i)
+    {
+        uint32_t bit = (uint32_t)(probe >> (i * 9 % 55)) & 511;
+        block[bit >> 6] |= (uint64_t)1 << (bit & 63);
+    }
+}
+
+static int pm_keyset_bloom_test(const uint64_t* bloom, uint64_t blocks, uint32_t hashes, uint64_t hash)
+{
+    const uint64_t* block = bloom + pm_keyset_bloom_block(blocks, hash) * 8;
+    uint64_t probe = pm_keyset_mix(hash);
+    for (uint32_t i = 0; i < hashes; ++i)
+    {
+        uint32_t bit = (uint32_t)(probe >> (i * 9 % 55)) & 511;
+        if (!(block[bit >> 6] & ((uint64_t)1 << (bit & 63))))
+            return 0;
+    }
+    return 1;
+}
+
+static uint32_t pm_keyset_bucket(const pm_keyset_header* header, uint64_t hash)
+{
+    return header->directory_bits == 0 ? 0 : (uint32_t)(hash >> (64 - header->directory_bits));
+}
+
+///
+/// @brief Points the set's views at the sections of its image after validating them.
+/// @return 0 on success, -5 if the image is malformed.
+///
+static int pm_keyset_attach(pm_keyset* set, const uint8_t* image, size_t image_size)
+{
+    const uint16_t probe = 1;
+    if (*(const uint8_t*)&probe != 1)
+        return -5; // the image format is little-endian
+
+    if (image_size < sizeof(pm_keyset_header))
+        return -5;
+
+    const pm_keyset_header* header = (const pm_keyset_header*)image;
+    // Bound every field by the image size first so the sums below cannot overflow.
+    if (header->magic != PM_KEYSET_MAGIC || header->version != PM_KEYSET_VERSION
+        || header->image_size != image_size || header->directory_bits > 31
+        || header->key_count > UINT32_MAX || header->bloom_blocks > image_size / 64
+        || header->directory_offset > image_size || header->records_offset > image_size
+        || header->bloom_offset > image_size)
+        return -5;
+
+    uint64_t buckets = (uint64_t)1 << header->directory_bits;
+
+    if (header->directory_offset < sizeof(pm_keyset_header) || header->directory_offset % 4 != 0
+        || header->records_offset < header->directory_offset + (buckets + 1) * sizeof(uint32_t)
+        || header->records_offset + header->key_count * PM_KEY_PACKED_SIZE > image_size
+        || (header->bloom_blocks != 0
+            && (header->bloom_offset % 64 != 0
+                || header->bloom_offset < header->records_offset + header->key_count * PM_KEY_PACKED_SIZE
+                || header->bloom_offset + header->bloom_blocks * 64 > image_size
+                || header->bloom_blocks > UINT32_MAX
+                || header->bloom_hashes == 0 || header->bloom_hashes > 16)))
+        return -5;
+
+    const uint32_t* directory = (const uint32_t*)(image + header->directory_offset);
+    if (directory[0] != 0 || directory[buckets] != header->key_count)
+        return -5;
+    for (uint64_t b = 0; b < buckets; ++b)
+    {
+        if (directory[b] > directory[b + 1])
+            return -5;
+    }
+
+    set->image = image;
+    set->image_size = image_size;
+    set->header = header;
+    set->directory = directory;
+    set->records = image + header->records_offset;
+    set->bloom = header->bloom_blocks != 0 ? (const uint64_t*)(image + header->bloom_offset) : NULL;
+    return 0;
+}
+
+typedef struct
+{
+    uint64_t hash;
+    uint8_t packed[PM_KEY_PACKED_SIZE];
+} pm_keyset_entry;
+
+///
+/// @brief Allocates a zeroed in-memory image on a cache line boundary, matching the
+///        page-aligned file mapping so each Bloom block is exactly one cache line.
+/// @param size Image size; images are always a multiple of 64 bytes.
+///
+static uint8_t* pm_keyset_image_alloc(size_t size)
+{
+    void* image = NULL;
+#ifdef _WIN32
+    image = _aligned_malloc(size, 64);
+#else
+    if (posix_memalign(&image, 64, size) != 0)
+        image = NULL;
+#endif
+    if (image != NULL)
+        memset(image, 0, size);
+    return (uint8_t*)image;
+}
+
+static void pm_keyset_image_free(const uint8_t* image)
+{
+#ifdef _WIN32
+    _aligned_free((void*)image);
+#else
+    free((void*)image);
+#endif
+}
+
+static int pm_keyset_entry_compare(const void* a, const void* b)
+{
+    const pm_keyset_entry* x = (const pm_keyset_entry*)a;
+    const pm_keyset_entry* y = (const pm_keyset_entry*)b;
+    if (x->hash != y->hash)
+        return x->hash < y->hash ? -1 : 1;
+    return memcmp(x->packed, y->packed, PM_KEY_PACKED_SIZE);
+}
+
+///
+/// @brief Builds an immutable set of license keys.
+/// @details Each key is packed into 11 bytes and filed in a hash-bucketed table with
+///          about four keys per bucket, so a lookup reads one directory entry and one
+///          or two cache lines of records. Duplicate keys are stored once.
+/// @param set Receives the new set; release it with pm_keyset_free().
+/// @param keys License keys in the pm_get_license_key() format.
+/// @param count Number of keys.
+/// @param bloom_bits_per_key Bloom prefilter size in bits per key, 0 to disable.
+///        10 bits per key rejects about 99% of absent keys before the table is read.
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments or a malformed key.
+///         -2 - memory allocation failed.
+///         -5 - big-endian host (the image format is little-endian).
+///
+int pm_keyset_create(pm_keyset** set, const char* const* keys, size_t count, int bloom_bits_per_key)
+{
+    if (set == NULL || (keys == NULL && count > 0) || count > UINT32_MAX
+        || bloom_bits_per_key < 0 || bloom_bits_per_key > 64)
+        return -1;
+    *set = NULL;
+
+    pm_keyset_entry* entries = (pm_keyset_entry*)malloc((count > 0 ? count : 1) * sizeof(pm_keyset_entry));
+    if (entries == NULL)
+        return -2;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (keys[i] == NULL || pm_keyset_pack(keys[i], entries[i].packed) != 0)
+        {
+            free(entries);
+            return -1;
+        }
+        entries[i].hash = pm_keyset_hash(entries[i].packed);
+    }
+
+    qsort(entries, count, sizeof(pm_keyset_entry), pm_keyset_entry_compare);
+
+    size_t unique = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (unique == 0 || pm_keyset_entry_compare(&entries[unique - 1], &entries[i]) != 0)
+            entries[unique++] = entries[i];
+    }
+
+    uint32_t directory_bits = 0;
+    while (directory_bits < 31 && ((uint64_t)PM_KEYSET_BUCKET_LOAD << directory_bits) < unique)
+        directory_bits++;
+    uint64_t buckets = (uint64_t)1 << directory_bits;
+
+    uint64_t bloom_blocks = 0;
+    uint32_t bloom_hashes = 0;
+    if (bloom_bits_per_key > 0 && unique > 0)
+    {
+        bloom_blocks = ((uint64_t)unique * (uint64_t)bloom_bits_per_key + 511) / 512;
+        bloom_hashes = (uint32_t)((bloom_bits_per_key * 69 + 50) / 100); // bits * ln 2
+        if (bloom_hashes < 1)
+            bloom_hashes = 1;
+        if (bloom_hashes > 16)
+            bloom_hashes = 16;
+    }
+
+    pm_keyset_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PM_KEYSET_MAGIC;
+    header.version = PM_KEYSET_VERSION;
+    header.key_count = unique;
+    header.directory_bits = directory_bits;
+    header.bloom_hashes = bloom_hashes;
+    header.bloom_blocks = bloom_blocks;
+    header.directory_offset = (sizeof(pm_keyset_header) + 63) & ~(uint64_t)63;
+    header.records_offset = header.directory_offset + (buckets + 1) * sizeof(uint32_t);
+    header.bloom_offset = (header.records_offset + unique * PM_KEY_PACKED_SIZE + 63) & ~(uint64_t)63;
+    header.image_size = header.bloom_offset + bloom_blocks * 64;
+
+    pm_keyset* result = (pm_keyset*)calloc(1, sizeof(pm_keyset));
+    uint8_t* image = pm_keyset_image_alloc((size_t)header.image_size);
+    if (result == NULL || image == NULL)
+    {
+        free(result);
+        pm_keyset_image_free(image);
+        free(entries);
+        return -2;
+    }
+
+    memcpy(image, &header, sizeof(header));
+    uint32_t* directory = (uint32_t*)(image + header.directory_offset);
+    uint8_t* records = image + header.records_offset;
+    uint64_t* bloom = (uint64_t*)(image + header.bloom_offset);
+
+    // Entries are sorted by hash, so each bucket is a contiguous run.
+    uint64_t bucket = 0;
+    for (size_t i = 0; i < unique; ++i)
+    {
+        uint32_t target = pm_keyset_bucket(&header, entries[i].hash);
+        while (bucket <= target)
+            directory[bucket++] = (uint32_t)i;
+
+        memcpy(records + i * PM_KEY_PACKED_SIZE, entries[i].packed, PM_KEY_PACKED_SIZE);
+        if (bloom_blocks != 0)
+            pm_keyset_bloom_add(bloom, bloom_blocks, bloom_hashes, entries[i].hash);
+    }
+    while (bucket <= buckets)
+        directory[bucket++] = (uint32_t)unique;
+
+    free(entries);
+
+    if (pm_keyset_attach(result, image, (size_t)header.image_size) != 0)
+    {
+        pm_keyset_image_free(image);
+        free(result);
+        return -5;
+    }
+
+    *set = result;
+    return 0;
+}
+
+///
+/// @brief Looks up one packed key.
+///
+static int pm_keyset_find(const pm_keyset* set, const uint8_t packed[PM_KEY_PACKED_SIZE], uint64_t hash)
+{
+    const pm_keyset_header* header = set->header;
+    if (set->bloom != NULL && !pm_keyset_bloom_test(set->bloom, header->bloom_blocks, header->bloom_hashes, hash))
+        return 0;
+
+    uint32_t bucket = pm_keyset_bucket(header, hash);
+    for (uint32_t i = set->directory[bucket]; i < set->directory[bucket + 1]; ++i)
+    {
+        if (memcmp(set->records + (size_t)i * PM_KEY_PACKED_SIZE, packed, PM_KEY_PACKED_SIZE) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+///
+/// @brief Checks whether a license key belongs to the set.
+/// @param set Set built by pm_keyset_create() or loaded by pm_keyset_open().
+/// @param key Null-terminated license key (e.g., "MNE9-N37G-JC81-AB5B").
+/// @return 1 if the key is in the set, 0 if not or if the key is malformed,
+///         -1 if set is NULL.
+///
+int pm_keyset_contains(const pm_keyset* set, const char* key)
+{
+    if (set == NULL)
+        return -1;
+
+    uint8_t packed[PM_KEY_PACKED_SIZE];
+    if (key == NULL || pm_keyset_pack(key, packed) != 0)
+        return 0;
+    return pm_keyset_find(set, packed, pm_keyset_hash(packed));
+}
+
+///
+/// @brief Checks many license keys at once.
+/// @details Keys are processed in groups of 16 and three stages: parse and hash,
+///          Bloom test and directory read, record compare. Each stage prefetches what
+///          the next one reads, so the cache misses of a group overlap.
+/// @param set Set built by pm_keyset_create() or loaded by pm_keyset_open().
+/// @param keys Null-terminated license keys.
+/// @param count Number of keys.
+/// @param results Receives 1 (present) or 0 (absent or malformed) per key.
+/// @return Number of keys found, -1 on invalid arguments.
+///
+long long pm_keyset_contains_batch(const pm_keyset* set, const char* const* keys, size_t count, uint8_t* results)
+{
+    if (set == NULL || (count > 0 && (keys == NULL || results == NULL)))
+        return -1;
+
+    const pm_keyset_header* header = set->header;
+    uint8_t packed[PM_KEYSET_BATCH_GROUP][PM_KEY_PACKED_SIZE];
+    uint64_t hashes[PM_KEYSET_BATCH_GROUP];
+    uint32_t first[PM_KEYSET_BATCH_GROUP];
+    uint32_t last[PM_KEYSET_BATCH_GROUP];
+    long long found = 0;
+
+    for (size_t start = 0; start < count; start += PM_KEYSET_BATCH_GROUP)
+    {
+        size_t group = count - start < PM_KEYSET_BATCH_GROUP ? count - start : PM_KEYSET_BATCH_GROUP;
+
+        // Stage 1: parse and hash, prefetch Bloom blocks and directory entries.
+        for (size_t i = 0; i < group; ++i)
+        {
+            const char* key = keys[start + i];
+            first[i] = last[i] = 0;
+            if (key == NULL || pm_keyset_pack(key, packed[i]) != 0)
+                continue;
+
+            hashes[i] = pm_keyset_hash(packed[i]);
+            last[i] = 1; // candidate
+            if (set->bloom != NULL)
+                PM_PREFETCH(set->bloom + pm_keyset_bloom_block(header->bloom_blocks, hashes[i]) * 8);
+            PM_PREFETCH(set->directory + pm_keyset_bucket(header, hashes[i]));
+        }
+
+        // Stage 2: Bloom rejection, bucket bounds, prefetch records.
+        for (size_t i = 0; i < group; ++i)
+        {
+            if (last[i] == 0)
+                continue;
+            if (set->bloom != NULL && !pm_keyset_bloom_test(set->bloom, header->bloom_blocks, header->bloom_hashes, hashes[i]))
+            {
+                last[i] = 0;
+                continue;
+            }
+
+            uint32_t bucket = pm_keyset_bucket(header, hashes[i]);
+            first[i] = set->directory[bucket];
+            last[i] = set->directory[bucket + 1];
+            PM_PREFETCH(set->records + (size_t)first[i] * PM_KEY_PACKED_SIZE);
+        }
+
+        // Stage 3: compare against the bucket's records.
+        for (size_t i = 0; i < group; ++i)
+        {
+            uint8_t hit = 0;
+            for (uint32_t r = first[i]; r < last[i] && !hit; ++r)
+                hit = memcmp(set->records + (size_t)r * PM_KEY_PACKED_SIZE, packed[i], PM_KEY_PACKED_SIZE) == 0;
+            results[start + i] = hit;
+            found += hit;
+        }
+    }
+
+    return found;
+}
+
+///
+/// @brief Returns the number of distinct keys in the set.
+///
+size_t pm_keyset_size(const pm_keyset* set)
+{
+    return set == NULL ? 0 : (size_t)set->header->key_count;
+}
+
+///
+/// @brief Writes the set to a file that pm_keyset_open() can map.
+/// @param set Set to serialize.
+/// @param path Output file path (created or truncated).
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments.
+///         -4 - the file could not be opened.
+///         -5 - writing the file failed.
+///
+int pm_keyset_save(const pm_keyset* set, const char* path)
+{
+    if (set == NULL || path == NULL)
+        return -1;
+
+    FILE* f = fopen(path, "wb");
+    if (f == NULL)
+        return -4;
+
+    size_t written = fwrite(set->image, 1, set->image_size, f);
+    int closed = fclose(f);
+    return (written == set->image_size && closed == 0) ? 0 : -5;
+}
+
+///
+/// @brief Maps a set written by pm_keyset_save().
+/// @details The file is mapped read-only and queried in place; nothing is copied
+///          or rebuilt. Opening validates the bucket directory in one sequential
+///          pass, about one byte per key, so it grows with the key count.
+/// @param set Receives the set; release it with pm_keyset_free().
+/// @param path File path.
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments.
+///         -2 - memory allocation or mapping failed.
+///         -4 - the file could not be opened.
+///         -5 - the file is not a valid key set.
+///
+int pm_keyset_open(pm_keyset** set, const char* path)
+{
+    if (set == NULL || path == NULL)
+        return -1;
+    *set = NULL;
+
+    pm_keyset* result = (pm_keyset*)calloc(1, sizeof(pm_keyset));
+    if (result == NULL)
+        return -2;
+    result->mapped = 1;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        free(result);
+        return -4;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < (LONGLONG)sizeof(pm_keyset_header))
+    {
+        CloseHandle(file);
+        free(result);
+        return -5;
+    }
+
+    result->mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    const uint8_t* image = result->mapping ? (const uint8_t*)MapViewOfFile(result->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (image == NULL)
+    {
+        if (result->mapping)
+            CloseHandle(result->mapping);
+        free(result);
+        return -2;
+    }
+    size_t image_size = (size_t)file_size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        free(result);
+        return -4;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(pm_keyset_header))
+    {
+        close(fd);
+        free(result);
+        return -5;
+    }
+
+    size_t image_size = (size_t)info.st_size;
+    void* mapping = mmap(NULL, image_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        free(result);
+        return -2;
+    }
+    const uint8_t* image = (const uint8_t*)mapping;
+#endif
+
+    if (pm_keyset_attach(result, image, image_size) != 0)
+    {
+        result->image = image;
+        result->image_size = image_size;
+        pm_keyset_free(result);
+        return -5;
+    }
+
+    *set = result;
+    return 0;
+}
+
+///
+/// @brief Releases a set from pm_keyset_create() or pm_keyset_open().
+///
+void pm_keyset_free(pm_keyset* set)
+{
+    if (set == NULL)
+        return;
+
+    if (set->mapped)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(set->image);
+        CloseHandle(set->mapping);
+#else
+        munmap((void*)set->image, set->image_size);
+#endif
+    }
+    else
+    {
+        pm_keyset_image_free(set->image);
+    }
+
+    free(set);
+}
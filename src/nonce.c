@@ -0,0 +1,613 @@
+#include <PRNG_mini.h>
+
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+//Supported by Linux, MacOS, BSD, Android, iOS, Unix-Like OS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Generators a thread caches counter blocks for at once; further ones share entries.
+#define PM_NONCE_CACHE_WAYS 8
+
+// Atomics: GCC/Clang builtins with the given memory order, or Interlocked functions
+// (full barriers) on MSVC, which has neither the builtins nor C11 atomics in C mode.
+#ifdef _MSC_VER
+#define PM_ATOMIC_LOAD_PTR(target, order) InterlockedCompareExchangePointer((PVOID volatile*)(target), NULL, NULL)
+#define PM_ATOMIC_STORE_PTR(target, value, order) ((void)InterlockedExchangePointer((PVOID volatile*)(target), (value)))
+#define PM_ATOMIC_EXCHANGE_PTR(target, value, order) InterlockedExchangePointer((PVOID volatile*)(target), (value))
+#define PM_ATOMIC_CAS_PTR(target, expected, desired, order) pm_atomic_cas_ptr((PVOID volatile*)(target), (PVOID*)(expected), (desired))
+#define PM_ATOMIC_LOAD_U64(target, order) ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(target), 0, 0))
+#define PM_ATOMIC_ADD_U64(target, value, order) ((uint64_t)InterlockedExchangeAdd64((volatile LONG64*)(target), (LONG64)(value)))
+#define PM_ATOMIC_CAS_U64(target, expected, desired, order) pm_atomic_cas_u64((target), (expected), (desired))
+#define PM_ATOMIC_STORE_LONG(target, value, order) ((void)InterlockedExchange((volatile LONG*)(target), (value)))
+#define PM_ATOMIC_CAS_LONG(target, expected, desired, order) \
+    (InterlockedCompareExchange((volatile LONG*)(target), (desired), *(expected)) == *(expected))
+
+static int pm_atomic_cas_ptr(PVOID volatile* target, PVOID* expected, PVOID desired)
+{
+    PVOID seen = InterlockedCompareExchangePointer(target, desired, *expected);
+    if (seen == *expected)
+        return 1;
+    *expected = seen;
+    return 0;
+}
+
+static int pm_atomic_cas_u64(volatile uint64_t* target, uint64_t* expected, uint64_t desired)
+{
+    uint64_t seen = (uint64_t)InterlockedCompareExchange64((volatile LONG64*)target, (LONG64)desired, (LONG64)*expected);
+    if (seen == *expected)
+        return 1;
+    *expected = seen;
+    return 0;
+}
+#else
+#define PM_ATOMIC_LOAD_PTR(target, order) __atomic_load_n((target), (order))
+#define PM_ATOMIC_STORE_PTR(target, value, order) __atomic_store_n((target), (value), (order))
+#define PM_ATOMIC_EXCHANGE_PTR(target, value, order) __atomic_exchange_n((target), (value), (order))
+#define PM_ATOMIC_CAS_PTR(target, expected, desired, order) \
+    __atomic_compare_exchange_n((target), (expected), (desired), 0, (order), __ATOMIC_RELAXED)
+#define PM_ATOMIC_LOAD_U64(target, order) __atomic_load_n((target), (order))
+#define PM_ATOMIC_ADD_U64(target, value, order) __atomic_fetch_add((target), (value), (order))
+#define PM_ATOMIC_CAS_U64(target, expected, desired, order) \
+    __atomic_compare_exchange_n((target), (expected), (desired), 0, (order), __ATOMIC_RELAXED)
+#define PM_ATOMIC_STORE_LONG(target, value, order) __atomic_store_n((target), (value), (order))
+#define PM_ATOMIC_CAS_LONG(target, expected, desired, order) \
+    __atomic_compare_exchange_n((target), (expected), (desired), 0, (order), __ATOMIC_RELAXED)
+#endif
+
+///
+/// @brief One key epoch: a random prefix and the shared counter behind it.
+/// @details Immutable once published except for `next`. A replaced epoch is retired
+///          and freed once no thread's hazard pointer refers to it any more.
+///
+typedef struct pm_nonce_epoch
+{
+    struct pm_nonce_epoch* retired_next;
+    uint64_t sequence;          // epochs of the generator before this one, never wraps
+    uint32_t process_id;        // process that created the epoch
+    uint64_t fork_generation;   // process generation the epoch belongs to
+    uint32_t prefix_high;       // nonce bytes 0..3
+    uint64_t prefix_low;        // nonce bytes 4..11, counter bits cleared
+    uint64_t next;              // first counter not yet reserved by any thread
+} pm_nonce_epoch;
+
+struct pm_nonce_gen
+{
+    uint64_t id;                // never reused, tags thread cache entries
+    uint64_t limit;             // counters per epoch
+    uint64_t block_size;
+    uint64_t counter_mask;
+    pm_nonce_epoch* current;
+    pm_nonce_epoch* retired;    // replaced epochs not freed yet
+};
+
+///
+/// @brief Counter block a thread reserved from one epoch: [next, end).
+///
+typedef struct
+{
+    uint64_t generator_id;
+    uint64_t epoch_sequence;
+    uint64_t next;
+    uint64_t end;
+} pm_nonce_block;
+
+///
+/// @brief Per-thread state, kept in a process-wide registry.
+/// @details Records are never freed: a thread that exits hands its record back for
+///          reuse, so scanning the registry never touches freed memory. The reserved
+///          blocks go with the record; they are still exclusively its own.
+///
+typedef struct pm_nonce_thread
+{
+    struct pm_nonce_thread* link;
+    long in_use;
+    pm_nonce_epoch* hazard;     // epoch this thread is issuing from, or NULL
+    pm_nonce_block blocks[PM_NONCE_CACHE_WAYS];
+} pm_nonce_thread;
+
+static uint64_t pm_nonce_next_id = 1;
+
+// Bumped in a forked child; epochs from an older generation are retired on next use.
+static uint64_t pm_nonce_fork_generation = 0;
+
+static pm_nonce_thread* pm_nonce_threads = NULL;
+
+#ifdef _WIN32
+static INIT_ONCE pm_nonce_once = INIT_ONCE_STATIC_INIT;
+static DWORD pm_nonce_thread_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_once_t pm_nonce_once = PTHREAD_ONCE_INIT;
+static pthread_key_t pm_nonce_thread_key;
+static int pm_nonce_thread_key_valid = 0;
+#endif
+
+///
+/// @brief Hands a thread's record back to the registry when the thread exits.
+///
+#ifdef _WIN32
+static void WINAPI pm_nonce_thread_release(void* state)
+#else
+static void pm_nonce_thread_release(void* state)
+#endif
+{
+    pm_nonce_thread* thread = (pm_nonce_thread*)state;
+    PM_ATOMIC_STORE_PTR(&thread->hazard, NULL, __ATOMIC_RELEASE);
+    PM_ATOMIC_STORE_LONG(&thread->in_use, 0, __ATOMIC_RELEASE);
+}
+
+#ifdef _WIN32
+static BOOL CALLBACK pm_nonce_init(PINIT_ONCE once, PVOID parameter, PVOID* context)
+{
+    (void)once;
+    (void)parameter;
+    (void)context;
+    pm_nonce_thread_key = FlsAlloc(pm_nonce_thread_release);
+    return TRUE;
+}
+#else
+static void pm_nonce_after_fork_child(void)
+{
+    PM_ATOMIC_ADD_U64(&pm_nonce_fork_generation, 1, __ATOMIC_RELAXED);
+}
+
+static void pm_nonce_init(void)
+{
+    pm_nonce_thread_key_valid = pthread_key_create(&pm_nonce_thread_key, pm_nonce_thread_release) == 0;
+    pthread_atfork(NULL, NULL, pm_nonce_after_fork_child);
+}
+#endif
+
+static void pm_nonce_ensure_init(void)
+{
+#ifdef _WIN32
+    InitOnceExecuteOnce(&pm_nonce_once, pm_nonce_init, NULL, NULL);
+#else
+    pthread_once(&pm_nonce_once, pm_nonce_init);
+#endif
+}
+
+///
+/// @brief Takes a free registry record or adds a new one.
+///
+static pm_nonce_thread* pm_nonce_thread_acquire(void)
+{
+    for (pm_nonce_thread* thread = PM_ATOMIC_LOAD_PTR(&pm_nonce_threads, __ATOMIC_ACQUIRE); thread != NULL; thread = thread->link)
+    {
+        long expected = 0;
+        if (PM_ATOMIC_CAS_LONG(&thread->in_use, &expected, 1, __ATOMIC_ACQUIRE))
+            return thread;
+    }
+
+    pm_nonce_thread* created = (pm_nonce_thread*)calloc(1, sizeof(pm_nonce_thread));
+    if (created == NULL)
+        return NULL;
+    created->in_use = 1;
+    created->link = PM_ATOMIC_LOAD_PTR(&pm_nonce_threads, __ATOMIC_RELAXED);
+    while (!PM_ATOMIC_CAS_PTR(&pm_nonce_threads, &created->link, created, __ATOMIC_RELEASE))
+        ;
+    return created;
+}
+
+///
+/// @brief Returns the calling thread's record, or NULL if none can be set up.
+///
+static pm_nonce_thread* pm_nonce_thread_state(void)
+{
+    pm_nonce_thread* state;
+
+#ifdef _WIN32
+    if (pm_nonce_thread_key == FLS_OUT_OF_INDEXES)
+        return NULL;
+    state = (pm_nonce_thread*)FlsGetValue(pm_nonce_thread_key);
+    if (state != NULL)
+        return state;
+    state = pm_nonce_thread_acquire();
+    if (state == NULL)
+        return NULL;
+    FlsSetValue(pm_nonce_thread_key, state);
+#else
+    if (!pm_nonce_thread_key_valid)
+        return NULL;
+    state = (pm_nonce_thread*)pthread_getspecific(pm_nonce_thread_key);
+    if (state != NULL)
+        return state;
+    state = pm_nonce_thread_acquire();
+    if (state == NULL)
+        return NULL;
+    if (pthread_setspecific(pm_nonce_thread_key, state) != 0)
+    {
+        pm_nonce_thread_release(state);
+        return NULL;
+    }
+#endif
+
+    return state;
+}
+
+static uint32_t pm_nonce_process_id(void)
+{
+#ifdef _WIN32
+    return (uint32_t)GetCurrentProcessId();
+#else
+    return (uint32_t)getpid();
+#endif
+}
+
+///
+/// @brief Creates an unpublished epoch with a fresh random prefix.
+/// @details The sequence continues from `previous`, also in a forked child; the
+///          process id tells a child's epochs from its parent's.
+/// @return 0 on success, -2 on allocation failure, device error code otherwise.
+///
+static int pm_nonce_epoch_create(pm_nonce_epoch** epoch, const pm_nonce_gen* gen, const pm_nonce_epoch* previous)
+{
+    uint8_t prefix[PM_NONCE_SIZE];
+    pm_nonce_epoch* created = (pm_nonce_epoch*)calloc(1, sizeof(pm_nonce_epoch));
+    if (created == NULL)
+        return -2;
+
+    int status = pm_fill_random_bytes(prefix, sizeof(prefix));
+    if (status != 0)
+    {
+        free(created);
+        return status;
+    }
+
+    for (int i = 0; i < 4; ++i)
+        created->prefix_high = (created->prefix_high << 8) | prefix[i];
+    for (int i = 4; i < PM_NONCE_SIZE; ++i)
+        created->prefix_low = (created->prefix_low << 8) | prefix[i];
+    created->prefix_low &= ~gen->counter_mask;
+
+    created->sequence = previous != NULL ? previous->sequence + 1 : 0;
+    created->process_id = pm_nonce_process_id();
+    created->fork_generation = PM_ATOMIC_LOAD_U64(&pm_nonce_fork_generation, __ATOMIC_RELAXED);
+    *epoch = created;
+    return 0;
+}
+
+///
+/// @brief Number reported to callers: process id and the low bits of the sequence.
+///
+static uint64_t pm_nonce_epoch_number(const pm_nonce_epoch* epoch)
+{
+    return (uint64_t)epoch->process_id << 32 | (uint32_t)epoch->sequence;
+}
+
+static void pm_nonce_retire(pm_nonce_gen* gen, pm_nonce_epoch* epoch)
+{
+    epoch->retired_next = PM_ATOMIC_LOAD_PTR(&gen->retired, __ATOMIC_RELAXED);
+    while (!PM_ATOMIC_CAS_PTR(&gen->retired, &epoch->retired_next, epoch, __ATOMIC_RELEASE))
+        ;
+}
+
+static int pm_nonce_hazardous(const pm_nonce_epoch* epoch)
+{
+    for (pm_nonce_thread* thread = PM_ATOMIC_LOAD_PTR(&pm_nonce_threads, __ATOMIC_ACQUIRE); thread != NULL; thread = thread->link)
+    {
+        if (PM_ATOMIC_LOAD_PTR(&thread->hazard, __ATOMIC_SEQ_CST) == epoch)
+            return 1;
+    }
+    return 0;
+}
+
+///
+/// @brief Frees retired epochs no thread is issuing from.
+/// @details Takes the whole retired list, so concurrent callers never free the same
+///          epoch; epochs still in use go back on the list for a later pass. At most
+///          one epoch per thread record stays behind, so memory is bounded by the
+///          number of threads rather than the number of rollovers.
+///
+static void pm_nonce_reclaim(pm_nonce_gen* gen)
+{
+    pm_nonce_epoch* epoch = PM_ATOMIC_EXCHANGE_PTR(&gen->retired, NULL, __ATOMIC_ACQUIRE);
+    while (epoch != NULL)
+    {
+        pm_nonce_epoch* next = epoch->retired_next;
+        if (pm_nonce_hazardous(epoch))
+            pm_nonce_retire(gen, epoch);
+        else
+            free(epoch);
+        epoch = next;
+    }
+}
+
+///
+/// @brief Replaces `seen` as the current epoch unless another thread already did.
+/// @details Lock-free: the first CAS from `seen` wins and losers discard their epoch,
+///          so a forked child can never block on a lock held by a parent thread.
+///          The caller must hold `seen` in its hazard pointer.
+///
+static int pm_nonce_roll(pm_nonce_gen* gen, pm_nonce_epoch* seen)
+{
+    pm_nonce_epoch* fresh = NULL;
+    int status = pm_nonce_epoch_create(&fresh, gen, seen);
+    if (status != 0)
+        return status;
+
+    pm_nonce_epoch* expected = seen;
+    if (!PM_ATOMIC_CAS_PTR(&gen->current, &expected, fresh, __ATOMIC_SEQ_CST))
+    {
+        free(fresh);
+        return 0;
+    }
+
+    pm_nonce_retire(gen, seen);
+    pm_nonce_reclaim(gen);
+    return 0;
+}
+
+///
+/// @brief Loads the current epoch into the thread's hazard pointer, first retiring
+///        it if it predates a fork.
+/// @details The epoch is re-read after the hazard is published: a reclaimer that
+///          replaced it in between either sees the hazard or was already visible.
+///
+static int pm_nonce_current(pm_nonce_gen* gen, pm_nonce_thread* thread, pm_nonce_epoch** epoch)
+{
+    for (;;)
+    {
+        pm_nonce_epoch* current = PM_ATOMIC_LOAD_PTR(&gen->current, __ATOMIC_ACQUIRE);
+        PM_ATOMIC_STORE_PTR(&thread->hazard, current, __ATOMIC_SEQ_CST);
+        if (PM_ATOMIC_LOAD_PTR(&gen->current, __ATOMIC_SEQ_CST) != current)
+            continue;
+
+        if (current->fork_generation == PM_ATOMIC_LOAD_U64(&pm_nonce_fork_generation, __ATOMIC_RELAXED))
+        {
+            *epoch = current;
+            return 0;
+        }
+
+        int status = pm_nonce_roll(gen, current);
+        if (status != 0)
+        {
+            PM_ATOMIC_STORE_PTR(&thread->hazard, NULL, __ATOMIC_RELEASE);
+            return status;
+        }
+    }
+}
+
+///
+/// @brief Reserves up to `want` counters from an epoch: [*start, *end).
+/// @details A CAS loop rather than fetch-add, so the shared counter never moves past
+///          the limit and cannot wrap however many threads find the epoch exhausted.
+/// @return 1 on success, 0 if the epoch is exhausted.
+///
+static int pm_nonce_reserve(const pm_nonce_gen* gen, pm_nonce_epoch* epoch, uint64_t want, uint64_t* start, uint64_t* end)
+{
+    uint64_t next = PM_ATOMIC_LOAD_U64(&epoch->next, __ATOMIC_RELAXED);
+    uint64_t reserved_end;
+
+    do
+    {
+        if (next >= gen->limit)
+            return 0;
+        reserved_end = gen->limit - next < want ? gen->limit : next + want;
+    } while (!PM_ATOMIC_CAS_U64(&epoch->next, &next, reserved_end, __ATOMIC_RELAXED));
+
+    *start = next;
+    *end = reserved_end;
+    return 1;
+}
+
+static void pm_nonce_write(uint8_t* nonce, const pm_nonce_epoch* epoch, uint64_t counter)
+{
+    uint64_t low = epoch->prefix_low | counter;
+    for (int i = 3; i >= 0; --i)
+        nonce[3 - i] = (uint8_t)(epoch->prefix_high >> (8 * i));
+    for (int i = 7; i >= 0; --i)
+        nonce[4 + 7 - i] = (uint8_t)(low >> (8 * i));
+}
+
+///
+/// @brief Issues nonces from one epoch into `nonces`.
+/// @details Uses the thread's cached block first, then reserves further blocks.
+///          Stops short when the epoch runs out, so every nonce of one call
+///          belongs to the same epoch; an exhausted epoch is rolled over only when
+///          nothing has been issued yet. Blocks are matched by epoch sequence, not
+///          address, since a freed epoch's memory may be reused.
+/// @return Number of nonces written (at least 1), or a negative error code.
+///
+static long long pm_nonce_issue(pm_nonce_gen* gen, uint8_t* nonces, size_t count, uint64_t* epoch_number)
+{
+    pm_nonce_thread* thread = pm_nonce_thread_state();
+    if (thread == NULL)
+        return -2;
+    pm_nonce_block* block = &thread->blocks[gen->id % PM_NONCE_CACHE_WAYS];
+
+    for (;;)
+    {
+        pm_nonce_epoch* epoch = NULL;
+        int status = pm_nonce_current(gen, thread, &epoch);
+        if (status != 0)
+            return status;
+
+        if (block->generator_id != gen->id || block->epoch_sequence != epoch->sequence)
+        {
+            block->generator_id = gen->id;
+            block->epoch_sequence = epoch->sequence;
+            block->next = 0;
+            block->end = 0;
+        }
+
+        size_t issued = 0;
+        while (issued < count)
+        {
+            if (block->next == block->end)
+            {
+                // Large batches reserve their remainder in one step.
+                uint64_t want = count - issued > gen->block_size ? (uint64_t)(count - issued) : gen->block_size;
+                if (!pm_nonce_reserve(gen, epoch, want, &block->next, &block->end))
+                    break;
+            }
+
+            pm_nonce_write(nonces + issued * PM_NONCE_SIZE, epoch, block->next++);
+            issued++;
+        }
+
+        if (issued > 0)
+        {
+            if (epoch_number != NULL)
+                *epoch_number = pm_nonce_epoch_number(epoch);
+            PM_ATOMIC_STORE_PTR(&thread->hazard, NULL, __ATOMIC_RELEASE);
+            return (long long)issued;
+        }
+
+        status = pm_nonce_roll(gen, epoch);
+        if (status != 0)
+        {
+            PM_ATOMIC_STORE_PTR(&thread->hazard, NULL, __ATOMIC_RELEASE);
+            return status;
+        }
+    }
+}
+
+///
+/// @brief PRNG mini - nonce generator creation
+/// @details Each 96-bit nonce is a random per-epoch prefix followed by a counter in its
+///          low `counter_bits`, big-endian. Threads reserve blocks of `block_size`
+///          counters from a shared atomic counter and issue from them without
+///          further synchronization or system calls.
+///          When an epoch's counters are used up, after pm_nonce_rekey(), and in a
+///          child process after fork(), the generator moves to a new epoch with a fresh
+///          prefix. Callers must encrypt under a fresh key whenever the reported epoch
+///          changes; within one epoch every nonce is distinct.
+///          Epoch numbers hold the creating process id in their upper 32 bits and the
+///          low 32 bits of the epoch sequence below, so a forked child and its parent
+///          never report the same number. Still draw every epoch's key from fresh
+///          randomness rather than deriving it from the number: a reused process id,
+///          or a sequence past 2^32 rollovers, could repeat one.
+/// @param gen Receives the generator; release it with pm_nonce_free().
+/// @param counter_bits Counter width, 16 to 64; the other 96 - counter_bits bits are random.
+/// @param block_size Counters reserved per thread at once, at least 1.
+/// @param max_per_epoch Nonces per epoch before a rollover, 0 for the full counter range.
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         -2 - memory allocation failed.
+///         other negative - device error codes as pm_fill_random_bytes().
+///
+int pm_nonce_create(pm_nonce_gen** gen, int counter_bits, uint32_t block_size, uint64_t max_per_epoch)
+{
+    if (gen == NULL || counter_bits < 16 || counter_bits > 64 || block_size == 0)
+        return -1;
+    *gen = NULL;
+
+    pm_nonce_ensure_init();
+
+    pm_nonce_gen* created = (pm_nonce_gen*)calloc(1, sizeof(pm_nonce_gen));
+    if (created == NULL)
+        return -2;
+
+    created->id = PM_ATOMIC_ADD_U64(&pm_nonce_next_id, 1, __ATOMIC_RELAXED);
+    created->counter_mask = counter_bits == 64 ? UINT64_MAX : (((uint64_t)1 << counter_bits) - 1);
+    // With 64 counter bits the last counter value stays unused so the limit fits.
+    created->limit = created->counter_mask + (counter_bits == 64 ? 0 : 1);
+    if (max_per_epoch != 0 && max_per_epoch < created->limit)
+        created->limit = max_per_epoch;
+    created->block_size = block_size;
+
+    int status = pm_nonce_epoch_create(&created->current, created, NULL);
+    if (status != 0)
+    {
+        free(created);
+        return status;
+    }
+
+    *gen = created;
+    return 0;
+}
+
+///
+/// @brief PRNG mini - next 96-bit nonce
+/// @param gen Generator from pm_nonce_create().
+/// @param nonce Receives PM_NONCE_SIZE bytes.
+/// @param epoch Receives the epoch the nonce belongs to (may be NULL).
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         other negative - errors starting a new epoch, as pm_nonce_create().
+///
+int pm_nonce_next(pm_nonce_gen* gen, uint8_t* nonce, uint64_t* epoch)
+{
+    if (gen == NULL || nonce == NULL)
+        return -1;
+
+    long long issued = pm_nonce_issue(gen, nonce, 1, epoch);
+    return issued < 0 ? (int)issued : 0;
+}
+
+///
+/// @brief PRNG mini - many 96-bit nonces
+/// @details Writes up to `count` nonces back to back, all from one epoch. Fewer are
+///          written only when that epoch runs out; the next call continues in the new one.
+/// @param gen Generator from pm_nonce_create().
+/// @param nonces Receives count * PM_NONCE_SIZE bytes.
+/// @param count Number of nonces wanted, at least 1.
+/// @param epoch Receives the epoch of the written nonces (may be NULL).
+/// @return Number of nonces written (at least 1),
+///         -1 - invalid arguments.
+///         other negative - errors starting a new epoch, as pm_nonce_create().
+///
+long long pm_nonce_batch(pm_nonce_gen* gen, uint8_t* nonces, size_t count, uint64_t* epoch)
+{
+    if (gen == NULL || nonces == NULL || count == 0)
+        return -1;
+
+    return pm_nonce_issue(gen, nonces, count, epoch);
+}
+
+///
+/// @brief PRNG mini - start a new nonce epoch
+/// @details For key rotation ahead of exhaustion. Blocks already reserved from the old
+///          epoch are abandoned by every thread.
+/// @param gen Generator from pm_nonce_create().
+/// @param epoch Receives the new epoch number (may be NULL).
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         other negative - errors as pm_nonce_create().
+///
+int pm_nonce_rekey(pm_nonce_gen* gen, uint64_t* epoch)
+{
+    if (gen == NULL)
+        return -1;
+
+    pm_nonce_thread* thread = pm_nonce_thread_state();
+    if (thread == NULL)
+        return -2;
+
+    pm_nonce_epoch* seen = NULL;
+    int status = pm_nonce_current(gen, thread, &seen);
+    if (status == 0)
+        status = pm_nonce_roll(gen, seen);
+    if (status == 0)
+        status = pm_nonce_current(gen, thread, &seen);
+    if (status == 0 && epoch != NULL)
+        *epoch = pm_nonce_epoch_number(seen);
+    PM_ATOMIC_STORE_PTR(&thread->hazard, NULL, __ATOMIC_RELEASE);
+    return status;
+}
+
+///
+/// @brief Releases a generator and all its epochs. No other thread may be using it.
+///
+void pm_nonce_free(pm_nonce_gen* gen)
+{
+    if (gen == NULL)
+        return;
+
+    pm_nonce_epoch* epoch = gen->retired;
+    while (epoch != NULL)
+    {
+        pm_nonce_epoch* next = epoch->retired_next;
+        free(epoch);
+        epoch = next;
+    }
+    free(gen->current);
+    free(gen);
+}
@@ -0,0 +1,231 @@
+#include <PRNG_mini.h>
+
+#include <string.h>
+#include <stdint.h>
+
+// Largest supported modulus: 4096 bits.
+#define PM_BELOW_MAX_BYTES 512
+#define PM_BELOW_MAX_LIMBS (PM_BELOW_MAX_BYTES / 8)
+
+// Random bytes drawn from the device per refill of a batch pool.
+#define PM_BELOW_POOL_SIZE 4096
+
+///
+/// @brief Public description of a modulus in 64-bit little-endian limbs.
+///
+typedef struct
+{
+    uint64_t limbs[PM_BELOW_MAX_LIMBS];
+    size_t limb_count;      // limbs up to and including the top non-zero one
+    uint64_t top_mask;      // clears candidate bits above the modulus bit length
+} pm_below_modulus;
+
+///
+/// @brief Source of candidate bytes: a pool refilled from the device.
+///
+typedef struct
+{
+    uint8_t bytes[PM_BELOW_POOL_SIZE];
+    size_t size;
+    size_t position;
+} pm_below_pool;
+
+static void pm_below_wipe(void* buffer, size_t length)
+{
+    volatile uint8_t* wipe = (volatile uint8_t*)buffer;
+    for (size_t i = 0; i < length; ++i)
+        wipe[i] = 0;
+}
+
+///
+/// @brief Loads `len` bytes of the given order into zero-padded little-endian limbs.
+///
+static void pm_below_load(uint64_t* limbs, size_t limb_count, const uint8_t* bytes, size_t len, int little_endian)
+{
+    memset(limbs, 0, limb_count * sizeof(uint64_t));
+    for (size_t i = 0; i < len; ++i)
+    {
+        size_t significance = little_endian ? i : len - 1 - i;
+        if (significance / 8 < limb_count)
+            limbs[significance / 8] |= (uint64_t)bytes[i] << (8 * (significance % 8));
+    }
+}
+
+static void pm_below_store(uint8_t* bytes, size_t len, const uint64_t* limbs, int little_endian)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        size_t significance = little_endian ? i : len - 1 - i;
+        bytes[i] = (uint8_t)(limbs[significance / 8] >> (8 * (significance % 8)));
+    }
+}
+
+///
+/// @brief Prepares a modulus; the modulus is public, so this may branch on it.
+/// @return 0 on success, -1 if the modulus is below 2.
+///
+static int pm_below_prepare(pm_below_modulus* modulus, const uint8_t* bytes, size_t len, int little_endian)
+{
+    size_t limb_count = (len + 7) / 8;
+    pm_below_load(modulus->limbs, limb_count, bytes, len, little_endian);
+
+    while (limb_count > 0 && modulus->limbs[limb_count - 1] == 0)
+        limb_count--;
+    if (limb_count == 0 || (limb_count == 1 && modulus->limbs[0] < 2))
+        return -1;
+
+    uint64_t top = modulus->limbs[limb_count - 1];
+    int bits = 0;
+    while (bits < 64 && (top >> bits) != 0)
+        bits++;
+
+    modulus->limb_count = limb_count;
+    modulus->top_mask = bits == 64 ? UINT64_MAX : (((uint64_t)1 << bits) - 1);
+    return 0;
+}
+
+///
+/// @brief Constant-time check of 1 <= candidate < modulus.
+/// @details Runs the full subtraction borrow chain and OR-reduction over every limb
+///          regardless of where the operands differ; returns 1 or 0 without branching
+///          on the candidate.
+///
+static uint64_t pm_below_in_range(const uint64_t* candidate, const pm_below_modulus* modulus)
+{
+    uint64_t borrow = 0;
+    uint64_t nonzero = 0;
+
+    for (size_t i = 0; i < modulus->limb_count; ++i)
+    {
+        uint64_t a = candidate[i];
+        uint64_t b = modulus->limbs[i];
+        uint64_t difference = a - b - borrow;
+        // borrow out of a - b - borrow, computed from sign bits without comparisons
+        borrow = ((~a & b) | (~(a ^ b) & difference)) >> 63;
+        nonzero |= a;
+    }
+
+    nonzero = (nonzero | (0 - nonzero)) >> 63;
+    return borrow & nonzero;
+}
+
+static int pm_below_pool_take(pm_below_pool* pool, uint8_t* output, size_t length)
+{
+    if (pool->position + length > pool->size)
+    {
+        int status = pm_fill_random_bytes(pool->bytes, pool->size);
+        if (status != 0)
+            return status;
+        pool->position = 0;
+    }
+
+    memcpy(output, pool->bytes + pool->position, length);
+    pm_below_wipe(pool->bytes + pool->position, length);
+    pool->position += length;
+    return 0;
+}
+
+///
+/// @brief Draws one value in [1, modulus) by masked rejection sampling.
+/// @details Candidates are cut to the modulus bit length, so each is accepted with
+///          probability above 1/2, and near 1 for moduli just below a power of two
+///          such as the P-256 order.
+///
+static int pm_below_sample(uint8_t* out, size_t len, const pm_below_modulus* modulus, int little_endian, pm_below_pool* pool)
+{
+    uint8_t raw[PM_BELOW_MAX_LIMBS * 8];
+    uint64_t candidate[PM_BELOW_MAX_LIMBS];
+    size_t draw = modulus->limb_count * 8;
+    int status = 0;
+
+    for (;;)
+    {
+        status = pm_below_pool_take(pool, raw, draw);
+        if (status != 0)
+            break;
+
+        pm_below_load(candidate, modulus->limb_count, raw, draw, 1);
+        candidate[modulus->limb_count - 1] &= modulus->top_mask;
+
+        // Only the accept/reject outcome is branched on; it reveals nothing about
+        // the accepted value.
+        if (pm_below_in_range(candidate, modulus))
+        {
+            // Limbs above the modulus are zero, so padding bytes of `out` read as zero
+            memset(candidate + modulus->limb_count, 0, (PM_BELOW_MAX_LIMBS - modulus->limb_count) * sizeof(uint64_t));
+            pm_below_store(out, len, candidate, little_endian);
+            break;
+        }
+    }
+
+    pm_below_wipe(raw, draw);
+    pm_below_wipe(candidate, modulus->limb_count * sizeof(uint64_t));
+    return status;
+}
+
+static int pm_below_generate(uint8_t* out, size_t count, const uint8_t* modulus_bytes, size_t len, int little_endian)
+{
+    if (out == NULL || modulus_bytes == NULL || len == 0 || len > PM_BELOW_MAX_BYTES || count == 0)
+        return -1;
+
+    pm_below_modulus modulus;
+    if (pm_below_prepare(&modulus, modulus_bytes, len, little_endian) != 0)
+        return -1;
+
+    // A single value draws two candidates up front, enough in most cases; batches
+    // share a full pool across values.
+    pm_below_pool pool;
+    pool.size = count == 1 ? 2 * modulus.limb_count * 8 : PM_BELOW_POOL_SIZE;
+    pool.position = pool.size;
+
+    int status = 0;
+    for (size_t i = 0; i < count && status == 0; ++i)
+        status = pm_below_sample(out + i * len, len, &modulus, little_endian, &pool);
+
+    pm_below_wipe(pool.bytes, pool.size);
+    return status;
+}
+
+///
+/// @brief PRNG mini - uniform big integer in [1, n), big-endian
+/// @details Samples a scalar for nonces, private keys or blinding factors, e.g. below
+///          the P-256 or Ed25519 group order. Uses masked rejection sampling and a
+///          constant-time range check.
+/// @param out Receives `len` bytes, big-endian, zero-padded to the modulus width.
+/// @param modulus Big-endian modulus n, at least 2.
+/// @param len Byte length of modulus and output, 1 to 512 (up to 4096 bits).
+/// @return 0 on success,
+///         -1 - invalid arguments (including n < 2).
+///         other negative - device error codes as pm_fill_random_bytes().
+///
+int pm_random_below(uint8_t* out, const uint8_t* modulus, size_t len)
+{
+    return pm_below_generate(out, 1, modulus, len, 0);
+}
+
+///
+/// @brief PRNG mini - uniform big integer in [1, n), little-endian
+/// @details Same as pm_random_below() with little-endian modulus and output,
+///          the convention of Ed25519 and X25519 scalars.
+///
+int pm_random_below_le(uint8_t* out, const uint8_t* modulus, size_t len)
+{
+    return pm_below_generate(out, 1, modulus, len, 1);
+}
+
+///
+/// @brief PRNG mini - many uniform big integers in [1, n)
+/// @details Generates `count` independent values back to back into `out`
+///          (count * len bytes). Candidates come from a shared 4 KiB pool,
+///          so device reads are amortized across values.
+/// @param out Receives count * len bytes.
+/// @param count Number of values.
+/// @param modulus Modulus n, at least 2.
+/// @param len Byte length of modulus and of each output value, 1 to 512.
+/// @param little_endian Non-zero for little-endian modulus and outputs.
+/// @return Same error codes as pm_random_below().
+///
+int pm_random_below_batch(uint8_t* out, size_t count, const uint8_t* modulus, size_t len, int little_endian)
+{
+    return pm_below_generate(out, count, modulus, len, little_endian ? 1 : 0);
+}
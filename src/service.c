@@ -0,0 +1,889 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // memfd_create, struct ucred
+#endif
+
+#include <PRNG_mini.h>
+
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+//Supported by Linux, MacOS, BSD, Android, iOS, Unix-Like OS
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+// "PMSV" - identifies a PRNG_mini service mapping
+#define PM_SERVICE_MAGIC 0x504D5356u
+#define PM_SERVICE_VERSION 3u
+
+// Bytes of randomness per ring block.
+#define PM_SERVICE_BLOCK_SIZE 4096
+
+// Daemon sleep between ring scans while every block is full (milliseconds).
+#define PM_SERVICE_IDLE_WAIT 1
+
+// How long a block may stay taken but unreturned before the daemon checks
+// whether its consumer died (milliseconds).
+#define PM_SERVICE_RECLAIM_WAIT 100
+
+// Claim word of a slot: ready for position p, owned by a consumer, or returned.
+#define PM_SERVICE_CLAIM_DONE UINT64_MAX
+
+#ifndef _WIN32
+///
+/// @brief Start of the shared mapping.
+/// @details The ring is a bounded single-producer, multi-consumer queue: block i is
+///          ready when sequences[i] == position + 1 and empty when it equals position
+///          (modulo the ring's laps). Consumers claim a block by advancing
+///          dequeue_position with a CAS, record themselves in the slot's claim
+///          word, copy the block out, wipe it and hand it back to the daemon by
+///          storing position + block_count into its sequence. The claim word, and
+///          the owner's start time recorded next to it, let the daemon take back
+///          blocks from consumers that died in between.
+///
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t block_count;
+    uint32_t block_size;
+    uint64_t mapping_size;
+    _Alignas(64) uint64_t enqueue_position;     // written by the daemon only
+    _Alignas(64) uint64_t dequeue_position;     // advanced by consumers
+} pm_service_header;
+
+typedef struct
+{
+    _Alignas(64) uint64_t sequence;
+    uint64_t claim;         // pm_service_claim_ready/owned for the current lap, or PM_SERVICE_CLAIM_DONE
+    uint64_t owner_start;   // start time of the claiming process, 0 until it is recorded
+} pm_service_slot;
+
+///
+/// @brief Daemon-side record of the block it is waiting on, for reclaiming.
+///
+typedef struct
+{
+    uint64_t position;
+    uint64_t since;     // monotonic milliseconds when the wait began
+} pm_service_stall;
+
+///
+/// @brief View of a mapped ring: header page, per-block sequences, then block data.
+///
+typedef struct
+{
+    uint8_t* base;
+    size_t size;
+    pm_service_header* header;
+    pm_service_slot* slots;
+    uint8_t* blocks;
+} pm_service_ring;
+
+///
+/// @brief Process-local client state.
+/// @details A block taken from the ring is served from `local` until used up.
+///          owner_pid drops the local bytes in a forked child, so parent and
+///          child never hand out the same bytes; owner_start is that process's
+///          start time, recorded in the slots it claims.
+///
+typedef struct
+{
+    pthread_mutex_t lock;
+    pm_service_ring ring;
+    int connected;
+    pid_t owner_pid;
+    uint64_t owner_start;
+    size_t local_position;
+    uint8_t local[PM_SERVICE_BLOCK_SIZE];
+    uint64_t service_blocks;
+    uint64_t fallback_calls;
+} pm_service_client;
+
+static pm_service_client pm_client = { .lock = PTHREAD_MUTEX_INITIALIZER, .local_position = PM_SERVICE_BLOCK_SIZE };
+
+static size_t pm_service_slots_offset(void)
+{
+    return (sizeof(pm_service_header) + 4095) & ~(size_t)4095;
+}
+
+static size_t pm_service_blocks_offset(uint32_t block_count)
+{
+    size_t end = pm_service_slots_offset() + (size_t)block_count * sizeof(pm_service_slot);
+    return (end + 4095) & ~(size_t)4095;
+}
+
+static size_t pm_service_mapping_size(uint32_t block_count)
+{
+    return pm_service_blocks_offset(block_count) + (size_t)block_count * PM_SERVICE_BLOCK_SIZE;
+}
+
+static void pm_service_ring_bind(pm_service_ring* ring, void* base, size_t size, uint32_t block_count)
+{
+    ring->base = (uint8_t*)base;
+    ring->size = size;
+    ring->header = (pm_service_header*)base;
+    ring->slots = (pm_service_slot*)(ring->base + pm_service_slots_offset());
+    ring->blocks = ring->base + pm_service_blocks_offset(block_count);
+}
+
+static void pm_service_wipe(void* buffer, size_t length)
+{
+    volatile uint8_t* wipe = (volatile uint8_t*)buffer;
+    for (size_t i = 0; i < length; ++i)
+        wipe[i] = 0;
+}
+
+static uint64_t pm_service_claim_ready(uint64_t position)
+{
+    return (uint32_t)position;
+}
+
+static uint64_t pm_service_claim_owned(uint64_t position, pid_t pid)
+{
+    return ((uint64_t)(uint32_t)pid << 32) | (uint32_t)position;
+}
+
+static uint64_t pm_service_now_ms(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+///
+/// @brief Start time of a process, in clock ticks since boot.
+/// @details Together with the pid it names one process: a reused pid comes with a
+///          later start time. Read from /proc on Linux.
+/// @return The start time, or 0 if it cannot be determined.
+///
+static uint64_t pm_service_start_time(pid_t pid)
+{
+#ifdef __linux__
+    char path[64];
+    char stat[512];
+    snprintf(path, sizeof(path), "/proc/%ld/stat", (long)pid);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return 0;
+    ssize_t length = read(fd, stat, sizeof(stat) - 1);
+    close(fd);
+    if (length <= 0)
+        return 0;
+    stat[length] = '\0';
+
+    // Fields after the parenthesized command name; starttime is field 22.
+    const char* field = strrchr(stat, ')');
+    for (int index = 2; field != NULL && index < 22; ++index)
+        field = strchr(field + 1, ' ');
+    return field != NULL ? strtoull(field + 1, NULL, 10) : 0;
+#else
+    (void)pid;
+    return 0;
+#endif
+}
+
+static int pm_service_address(const char* socket_path, struct sockaddr_un* address)
+{
+    if (socket_path == NULL || strlen(socket_path) >= sizeof(address->sun_path))
+        return -1;
+
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    strcpy(address->sun_path, socket_path);
+    return 0;
+}
+
+///
+/// @brief Claims one ready block and copies it into `output`.
+/// @details Between winning the dequeue CAS and recording `pid` in the claim word
+///          the daemon may decide the consumer died and take the block back; the
+///          failed claim CAS then sends this consumer on to the next block.
+///          `start` is stored only once the claim is won, so a consumer left behind
+///          from an earlier lap never overwrites the owner's.
+/// @return 1 if a block was taken, 0 if the ring is empty.
+///
+static int pm_service_ring_take(pm_service_ring* ring, uint8_t* output, pid_t pid, uint64_t start)
+{
+    pm_service_header* header = ring->header;
+    uint32_t block_count = header->block_count;
+    uint64_t position = __atomic_load_n(&header->dequeue_position, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        pm_service_slot* slot = &ring->slots[position % block_count];
+        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+
+        if (sequence == position + 1)
+        {
+            if (__atomic_compare_exchange_n(&header->dequeue_position, &position, position + 1,
+                    1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                uint64_t claim = pm_service_claim_ready(position);
+                uint64_t owned = pm_service_claim_owned(position, pid);
+                if (!__atomic_compare_exchange_n(&slot->claim, &claim, owned, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                {
+                    position = __atomic_load_n(&header->dequeue_position, __ATOMIC_RELAXED);
+                    continue; // reclaimed by the daemon
+                }
+                __atomic_store_n(&slot->owner_start, start, __ATOMIC_RELEASE);
+
+                uint8_t* block = ring->blocks + (position % block_count) * PM_SERVICE_BLOCK_SIZE;
+                memcpy(output, block, PM_SERVICE_BLOCK_SIZE);
+                pm_service_wipe(block, PM_SERVICE_BLOCK_SIZE);
+
+                if (!__atomic_compare_exchange_n(&slot->claim, &owned, PM_SERVICE_CLAIM_DONE, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+                {
+                    // Taken back while copying (only if our pid looked dead): drop the copy.
+                    pm_service_wipe(output, PM_SERVICE_BLOCK_SIZE);
+                    position = __atomic_load_n(&header->dequeue_position, __ATOMIC_RELAXED);
+                    continue;
+                }
+
+                // A CAS, so a return delayed past a reclaim cannot move the sequence back.
+                uint64_t ready = position + 1;
+                __atomic_compare_exchange_n(&slot->sequence, &ready, position + block_count,
+                    0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+                return 1;
+            }
+            // CAS failure reloaded position; retry with it
+        }
+        else if (sequence < position + 1)
+        {
+            return 0; // not produced yet: ring is empty
+        }
+        else
+        {
+            position = __atomic_load_n(&header->dequeue_position, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+///
+/// @brief Daemon side: decides whether an unreturned block may be taken back.
+/// @details The block for `position` was last handed out for position - block_count.
+///          Once it has been held for PM_SERVICE_RECLAIM_WAIT it is reclaimed if its
+///          consumer never recorded itself in the claim word (it died, or is paused,
+///          right after the dequeue CAS), recorded a pid that no longer exists or now
+///          belongs to a process with a different start time, or finished with the
+///          block but never stored its sequence. Until the owner's start time is
+///          recorded only the pid is checked.
+///          A reclaimed block is overwritten before anyone else can take it, so a
+///          paused consumer that wakes up later never reads the same bytes.
+/// @return 1 if the block may be refilled, 0 to keep waiting.
+///
+static int pm_service_ring_reclaim(pm_service_ring* ring, pm_service_slot* slot, uint64_t position, pm_service_stall* stall)
+{
+    uint32_t block_count = ring->header->block_count;
+    if (position < block_count)
+        return 0;
+
+    uint64_t previous = position - block_count;
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != previous + 1
+        || __atomic_load_n(&ring->header->dequeue_position, __ATOMIC_RELAXED) <= previous)
+        return 0; // still queued, not taken
+
+    uint64_t now = pm_service_now_ms();
+    if (stall->position != position)
+    {
+        stall->position = position;
+        stall->since = now;
+        return 0;
+    }
+    if (now - stall->since < PM_SERVICE_RECLAIM_WAIT)
+        return 0;
+
+    uint64_t claim = __atomic_load_n(&slot->claim, __ATOMIC_ACQUIRE);
+    if (claim == PM_SERVICE_CLAIM_DONE)
+    {
+        stall->position = UINT64_MAX;
+        return 1; // copied and wiped; only the sequence store is missing
+    }
+    if (claim != pm_service_claim_ready(previous))
+    {
+        pid_t owner = (pid_t)(uint32_t)(claim >> 32);
+        if (kill(owner, 0) == 0 || errno != ESRCH)
+        {
+            // The pid is in use: by the consumer, unless it was reused since.
+            uint64_t recorded = __atomic_load_n(&slot->owner_start, __ATOMIC_ACQUIRE);
+            uint64_t current = pm_service_start_time(owner);
+            if (recorded == 0 || current == 0 || current == recorded)
+                return 0; // consumer alive, or unknown: keep waiting
+        }
+    }
+
+    if (!__atomic_compare_exchange_n(&slot->claim, &claim, PM_SERVICE_CLAIM_DONE, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        return 0;
+
+    stall->position = UINT64_MAX;
+    return 1;
+}
+
+///
+/// @brief Daemon side: fills every empty block.
+/// @return Number of blocks produced, or a negative device error code.
+///
+static int pm_service_ring_produce(pm_service_ring* ring, pm_service_stall* stall)
+{
+    pm_service_header* header = ring->header;
+    uint32_t block_count = header->block_count;
+    int produced = 0;
+
+    for (;;)
+    {
+        uint64_t position = header->enqueue_position;
+        pm_service_slot* slot = &ring->slots[position % block_count];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != position
+            && !pm_service_ring_reclaim(ring, slot, position, stall))
+            return produced; // consumers have not released this block yet
+
+        uint8_t* block = ring->blocks + (position % block_count) * PM_SERVICE_BLOCK_SIZE;
+        int status = pm_fill_random_bytes(block, PM_SERVICE_BLOCK_SIZE);
+        if (status != 0)
+            return status;
+
+        __atomic_store_n(&slot->claim, pm_service_claim_ready(position), __ATOMIC_RELAXED);
+        __atomic_store_n(&slot->owner_start, 0, __ATOMIC_RELAXED);
+        header->enqueue_position = position + 1;
+        __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+        produced++;
+    }
+}
+
+///
+/// @brief Creates an anonymous shared memory object sized for the ring.
+/// @return File descriptor, or -1 on failure.
+///
+static int pm_service_create_memory(size_t size)
+{
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    int fd = memfd_create("pm_service", MFD_CLOEXEC);
+    if (fd < 0)
+        return -1;
+#else
+    char name[64];
+    snprintf(name, sizeof(name), "/pm_service_%ld_%p", (long)getpid(), (void*)&name);
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return -1;
+    shm_unlink(name); // reachable only through descriptors from here on
+#endif
+
+    if (ftruncate(fd, (off_t)size) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+///
+/// @brief Hands the shared memory descriptor to a connected client.
+///
+static void pm_service_send_memory(int client, int memory_fd)
+{
+    char tag = 'M';
+    struct iovec io = { .iov_base = &tag, .iov_len = 1 };
+    union
+    {
+        char buffer[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(header), &memory_fd, sizeof(int));
+
+#ifdef MSG_NOSIGNAL
+    sendmsg(client, &message, MSG_NOSIGNAL);
+#else
+    sendmsg(client, &message, 0);
+#endif
+}
+
+///
+/// @brief Reads the effective uid of the process at the other end of a Unix socket.
+/// @return 0 on success, -1 if it cannot be determined on this OS.
+///
+static int pm_service_peer_uid(int connection, uid_t* uid)
+{
+#if defined(__linux__) && defined(SO_PEERCRED)
+    struct ucred credentials;
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(connection, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0)
+        return -1;
+    *uid = credentials.uid;
+    return 0;
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+    gid_t gid;
+    return getpeereid(connection, uid, &gid) == 0 ? 0 : -1;
+#else
+    (void)connection;
+    (void)uid;
+    return -1;
+#endif
+}
+
+///
+/// @brief Daemon side: a Linux peer must share the daemon's pid namespace, and so
+///        must its future children, since consumers are identified by pid.
+///
+static int pm_service_peer_same_namespace(int connection)
+{
+#if defined(__linux__) && defined(SO_PEERCRED)
+    struct ucred credentials;
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(connection, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0 || credentials.pid <= 0)
+        return 0; // a pid of 0 is not visible from this namespace
+
+    const char* names[] = { "pid", "pid_for_children" };
+    for (int i = 0; i < 2; ++i)
+    {
+        char own_path[64];
+        char peer_path[64];
+        struct stat own;
+        struct stat peer;
+        snprintf(own_path, sizeof(own_path), "/proc/self/ns/%s", names[i]);
+        snprintf(peer_path, sizeof(peer_path), "/proc/%ld/ns/%s", (long)credentials.pid, names[i]);
+        if (stat(own_path, &own) != 0)
+            continue; // kernel without this namespace file
+        if (stat(peer_path, &peer) != 0 || peer.st_dev != own.st_dev || peer.st_ino != own.st_ino)
+            return 0;
+    }
+    return 1;
+#else
+    (void)connection;
+    return 1;
+#endif
+}
+
+///
+/// @brief Daemon side: only processes of the daemon's own user, in its pid
+///        namespace, may attach.
+///
+static int pm_service_peer_allowed(int client)
+{
+    uid_t uid;
+    return pm_service_peer_uid(client, &uid) == 0 && uid == geteuid() && pm_service_peer_same_namespace(client);
+}
+
+///
+/// @brief Client side: the socket file must belong to this user and be closed to
+///        group and others, so no other user can have bound it.
+///
+static int pm_service_socket_trusted(const char* socket_path)
+{
+    struct stat info;
+    if (lstat(socket_path, &info) != 0 || !S_ISSOCK(info.st_mode) || info.st_uid != geteuid())
+        return 0;
+    return (info.st_mode & (S_IRWXG | S_IRWXO)) == 0;
+}
+
+///
+/// @brief Client side: the daemon must run as this user, the only user it serves.
+///
+static int pm_service_daemon_trusted(int connection)
+{
+    uid_t uid;
+    return pm_service_peer_uid(connection, &uid) == 0 && uid == geteuid();
+}
+#endif
+
+///
+/// @brief Runs the randomness service daemon in the calling thread.
+/// @details Creates a shared-memory ring of 4 KiB blocks, keeps it filled with
+///          device randomness and hands the ring to processes connecting on
+///          `socket_path`. Returns once *stop becomes non-zero. Every process
+///          attached to the ring can read its blocks, so the socket is created
+///          with mode 0600 and peers of another user, or on Linux of another pid
+///          namespace, are refused. Blocks taken by a consumer that died before
+///          returning them are reclaimed; on Linux a consumer is matched by pid and
+///          start time, so a reused pid does not hold its blocks.
+/// @param socket_path Filesystem path of the Unix socket.
+/// @param block_count Number of blocks in the ring (at least 2).
+/// @param stop Flag polled by the daemon loop, e.g. set from a signal handler.
+/// @return 0 after a requested stop, negative error code on failure:
+///         -1 - invalid arguments or unsupported platform.
+///         -2 - shared memory setup failed.
+///         -3 - random bytes generation failed.
+///         -4 - socket setup failed or another daemon serves this path.
+///
+int pm_service_run(const char* socket_path, uint32_t block_count, const volatile int* stop)
+{
+#ifdef _WIN32
+    (void)socket_path;
+    (void)block_count;
+    (void)stop;
+    return -1;
+#else
+    struct sockaddr_un address;
+    if (stop == NULL || block_count < 2 || pm_service_address(socket_path, &address) != 0)
+        return -1;
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+        return -4;
+
+    // A live daemon answers on the path; only a refused connection marks a stale
+    // socket file that may be replaced.
+    if (connect(listener, (struct sockaddr*)&address, sizeof(address)) == 0)
+    {
+        close(listener);
+        return -4;
+    }
+    int connect_error = errno;
+    close(listener);
+    if (connect_error == ECONNREFUSED)
+        unlink(socket_path);
+    else if (connect_error != ENOENT)
+        return -4;
+
+    size_t size = pm_service_mapping_size(block_count);
+    int memory_fd = pm_service_create_memory(size);
+    if (memory_fd < 0)
+        return -2;
+
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, memory_fd, 0);
+    if (base == MAP_FAILED)
+    {
+        close(memory_fd);
+        return -2;
+    }
+
+    pm_service_ring ring;
+    pm_service_ring_bind(&ring, base, size, block_count);
+    ring.header->block_count = block_count;
+    ring.header->block_size = PM_SERVICE_BLOCK_SIZE;
+    ring.header->mapping_size = size;
+    ring.header->version = PM_SERVICE_VERSION;
+    for (uint32_t i = 0; i < block_count; ++i)
+        ring.slots[i].sequence = i;
+
+    pm_service_stall stall = { .position = UINT64_MAX, .since = 0 };
+    int status = pm_service_ring_produce(&ring, &stall);
+    if (status >= 0)
+        __atomic_store_n(&ring.header->magic, PM_SERVICE_MAGIC, __ATOMIC_RELEASE);
+
+    // The socket is restricted to 0600 before listen(), so no connection is accepted
+    // while it still carries the default mode.
+    struct stat bound;
+    int bound_valid = 0;
+    listener = status >= 0 ? socket(AF_UNIX, SOCK_STREAM, 0) : -1;
+    if (status < 0)
+    {
+        status = -3;
+    }
+    else if (listener < 0 || bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0)
+    {
+        status = -4;
+    }
+    else
+    {
+        bound_valid = lstat(socket_path, &bound) == 0;
+        if (!bound_valid || chmod(socket_path, S_IRUSR | S_IWUSR) != 0 || listen(listener, 64) != 0)
+            status = -4;
+    }
+
+    while (status >= 0 && !*stop)
+    {
+        struct pollfd waiting = { .fd = listener, .events = POLLIN, .revents = 0 };
+        int produced = pm_service_ring_produce(&ring, &stall);
+        if (produced < 0)
+        {
+            status = -3;
+            break;
+        }
+
+        if (poll(&waiting, 1, produced > 0 ? 0 : PM_SERVICE_IDLE_WAIT) > 0 && (waiting.revents & POLLIN))
+        {
+            int client = accept(listener, NULL, NULL);
+            if (client >= 0)
+            {
+                if (pm_service_peer_allowed(client))
+                    pm_service_send_memory(client, memory_fd);
+                close(client);
+            }
+        }
+    }
+
+    if (listener >= 0)
+    {
+        // Remove the path only while it is still this daemon's socket.
+        struct stat current;
+        if (bound_valid && lstat(socket_path, &current) == 0
+            && current.st_dev == bound.st_dev && current.st_ino == bound.st_ino)
+            unlink(socket_path);
+        close(listener);
+    }
+
+    // Claim and wipe every ready block through the consumer protocol, so clients
+    // still attached see an empty ring from here on and fall back.
+    uint8_t scratch[PM_SERVICE_BLOCK_SIZE];
+    while (pm_service_ring_take(&ring, scratch, getpid(), 0))
+        ;
+    pm_service_wipe(scratch, sizeof(scratch));
+    munmap(base, size);
+    close(memory_fd);
+
+    return status < 0 ? status : 0;
+#endif
+}
+
+///
+/// @brief Attaches this process to a running randomness service.
+/// @details After a successful connect pm_service_bytes() draws from the daemon's
+///          ring. Connecting again replaces the previous attachment. The socket file
+///          must be owned by this user with no group or other access, and the daemon
+///          must run as this user; otherwise the connection is refused and
+///          pm_service_bytes() keeps using the in-process path.
+/// @param socket_path Filesystem path of the daemon's Unix socket.
+/// @return 0 on success, negative error code on failure:
+///         -1 - invalid arguments or unsupported platform.
+///         -2 - mapping the shared memory failed.
+///         -4 - no trusted daemon answered on the socket.
+///         -5 - the daemon's ring has an unexpected layout or version.
+///
+int pm_service_connect(const char* socket_path)
+{
+#ifdef _WIN32
+    (void)socket_path;
+    return -1;
+#else
+    struct sockaddr_un address;
+    if (pm_service_address(socket_path, &address) != 0)
+        return -1;
+
+    if (!pm_service_socket_trusted(socket_path))
+        return -4;
+
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection < 0)
+        return -4;
+    if (connect(connection, (struct sockaddr*)&address, sizeof(address)) != 0
+        || !pm_service_daemon_trusted(connection))
+    {
+        close(connection);
+        return -4;
+    }
+
+    char tag = 0;
+    struct iovec io = { .iov_base = &tag, .iov_len = 1 };
+    union
+    {
+        char buffer[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    ssize_t received;
+    do
+    {
+        received = recvmsg(connection, &message, 0);
+    } while (received < 0 && errno == EINTR);
+    close(connection);
+
+    // Take ownership of any descriptor that came along before judging the message,
+    // so a rejected one is closed rather than leaked.
+    int memory_fd = -1;
+    if (received >= 0)
+    {
+        for (struct cmsghdr* header = CMSG_FIRSTHDR(&message); header != NULL; header = CMSG_NXTHDR(&message, header))
+        {
+            if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS
+                || header->cmsg_len < CMSG_LEN(sizeof(int)))
+                continue;
+            int passed;
+            memcpy(&passed, CMSG_DATA(header), sizeof(int));
+            if (memory_fd < 0)
+                memory_fd = passed;
+            else
+                close(passed);
+        }
+    }
+    if (received != 1 || tag != 'M' || memory_fd < 0)
+    {
+        if (memory_fd >= 0)
+            close(memory_fd);
+        return -5;
+    }
+
+    struct stat info;
+    if (fstat(memory_fd, &info) != 0 || (size_t)info.st_size < sizeof(pm_service_header))
+    {
+        close(memory_fd);
+        return -5;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, memory_fd, 0);
+    close(memory_fd);
+    if (base == MAP_FAILED)
+        return -2;
+
+    const pm_service_header* shared = (const pm_service_header*)base;
+    if (__atomic_load_n(&shared->magic, __ATOMIC_ACQUIRE) != PM_SERVICE_MAGIC
+        || shared->version != PM_SERVICE_VERSION
+        || shared->block_size != PM_SERVICE_BLOCK_SIZE
+        || shared->block_count < 2
+        || shared->mapping_size != size
+        || pm_service_mapping_size(shared->block_count) != size)
+    {
+        munmap(base, size);
+        return -5;
+    }
+
+    pthread_mutex_lock(&pm_client.lock);
+    if (pm_client.connected)
+        munmap(pm_client.ring.base, pm_client.ring.size);
+    pm_service_ring_bind(&pm_client.ring, base, size, shared->block_count);
+    pm_client.connected = 1;
+    pthread_mutex_unlock(&pm_client.lock);
+
+    return 0;
+#endif
+}
+
+///
+/// @brief Detaches this process from the randomness service.
+/// @details Unused bytes held locally are wiped; later draws use the in-process path.
+///
+void pm_service_disconnect(void)
+{
+#ifndef _WIN32
+    pthread_mutex_lock(&pm_client.lock);
+    if (pm_client.connected)
+        munmap(pm_client.ring.base, pm_client.ring.size);
+    memset(&pm_client.ring, 0, sizeof(pm_client.ring));
+    pm_client.connected = 0;
+    pm_service_wipe(pm_client.local, sizeof(pm_client.local));
+    pm_client.local_position = PM_SERVICE_BLOCK_SIZE;
+    pthread_mutex_unlock(&pm_client.lock);
+#endif
+}
+
+///
+/// @brief PRNG mini - service based - random bytes generation
+/// @details Draws blocks from the attached service's ring. When no service is
+///          attached or the ring is empty (daemon busy or gone), the remainder is
+///          generated in-process with pm_fill_random_bytes().
+/// @param buffer Pointer to memory where random bytes will be written.
+/// @param length Number of bytes to generate.
+/// @return 0 on success,
+///         -1 - invalid arguments.
+///         other negative - device error codes from the in-process fallback.
+///
+int pm_service_bytes(void* buffer, size_t length)
+{
+    if (buffer == NULL)
+        return -1;
+    if (length == 0)
+        return 0;
+
+#ifdef _WIN32
+    return pm_fill_random_bytes(buffer, length);
+#else
+    uint8_t* output = (uint8_t*)buffer;
+
+    pthread_mutex_lock(&pm_client.lock);
+
+    if (pm_client.owner_pid != getpid())
+    {
+        // Forked child: never reuse bytes the parent may also hand out.
+        pm_service_wipe(pm_client.local, sizeof(pm_client.local));
+        pm_client.local_position = PM_SERVICE_BLOCK_SIZE;
+        pm_client.owner_pid = getpid();
+        pm_client.owner_start = pm_service_start_time(pm_client.owner_pid);
+    }
+
+    while (length > 0 && pm_client.connected)
+    {
+        if (pm_client.local_position < PM_SERVICE_BLOCK_SIZE)
+        {
+            size_t available = PM_SERVICE_BLOCK_SIZE - pm_client.local_position;
+            size_t chunk = length < available ? length : available;
+            memcpy(output, pm_client.local + pm_client.local_position, chunk);
+            pm_service_wipe(pm_client.local + pm_client.local_position, chunk);
+            pm_client.local_position += chunk;
+            output += chunk;
+            length -= chunk;
+            continue;
+        }
+
+        // Whole blocks go straight to the caller; a partial block is kept locally.
+        uint8_t* target = length >= PM_SERVICE_BLOCK_SIZE ? output : pm_client.local;
+        if (!pm_service_ring_take(&pm_client.ring, target, pm_client.owner_pid, pm_client.owner_start))
+            break;
+
+        pm_client.service_blocks++;
+        if (target == output)
+        {
+            output += PM_SERVICE_BLOCK_SIZE;
+            length -= PM_SERVICE_BLOCK_SIZE;
+        }
+        else
+        {
+            pm_client.local_position = 0;
+        }
+    }
+
+    if (length > 0)
+        pm_client.fallback_calls++;
+
+    pthread_mutex_unlock(&pm_client.lock);
+
+    return length > 0 ? pm_fill_random_bytes(output, length) : 0;
+#endif
+}
+
+///
+/// @brief Reports how this process has been served since it started.
+/// @param service_blocks Receives the number of blocks taken from the service ring (may be NULL).
+/// @param fallback_calls Receives the number of calls that used the in-process path (may be NULL).
+///
+void pm_service_stats(uint64_t* service_blocks, uint64_t* fallback_calls)
+{
+#ifdef _WIN32
+    if (service_blocks)
+        *service_blocks = 0;
+    if (fallback_calls)
+        *fallback_calls = 0;
+#else
+    pthread_mutex_lock(&pm_client.lock);
+    if (service_blocks)
+        *service_blocks = pm_client.service_blocks;
+    if (fallback_calls)
+        *fallback_calls = pm_client.fallback_calls;
+    pthread_mutex_unlock(&pm_client.lock);
+#endif
+}
@@ -0,0 +1,247 @@
+#include <PRNG_mini.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef _WIN32
+int main(void)
+{
+    printf("Buffered modes benchmark requires POSIX threads; skipped.\n");
+    return 0;
+}
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Draws per thread in the benchmark runs; several refills per thread, so threads
+// contend on the mode's state rather than finish before their siblings start
+#define DRAWS_PER_THREAD    20000
+
+// Uniqueness check: every word drawn across threads must be distinct
+#define CHECK_THREADS       64
+#define CHECK_DRAWS         4096
+
+// Holds workers until all of them exist, so they draw at the same time
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    int waiting;
+    int open;
+} StartGate;
+
+typedef struct
+{
+    StartGate* gate;
+    uint64_t* output;       // optional: where to store drawn words
+    int draws;
+    int failed;
+} WorkerArgs;
+
+static const char* mode_names[] = { "thread-local", "global-locked", "per-CPU" };
+
+double seconds_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+void* worker(void* argument)
+{
+    WorkerArgs* args = (WorkerArgs*)argument;
+    uint64_t sink = 0;
+
+    pthread_mutex_lock(&args->gate->lock);
+    args->gate->waiting++;
+    pthread_cond_broadcast(&args->gate->changed);
+    while (!args->gate->open)
+        pthread_cond_wait(&args->gate->changed, &args->gate->lock);
+    pthread_mutex_unlock(&args->gate->lock);
+
+    for (int i = 0; i < args->draws; ++i)
+    {
+        uint64_t value;
+        if (pm_buffered_u64(&value) != 0)
+        {
+            args->failed = 1;
+            break;
+        }
+        if (args->output)
+            args->output[i] = value;
+        sink ^= value;
+    }
+
+    if (sink == 0 && args->draws > 1)
+        args->failed = 1;
+    return NULL;
+}
+
+// Runs `threads` workers; returns elapsed seconds or a negative value on failure
+double run_threads(int threads, int draws, uint64_t* output)
+{
+    pthread_t* ids = malloc(sizeof(pthread_t) * threads);
+    WorkerArgs* args = calloc(threads, sizeof(WorkerArgs));
+    if (!ids || !args)
+    {
+        free(ids);
+        free(args);
+        return -1.0;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 64 * 1024);
+
+    StartGate gate = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0 };
+    int started = 0;
+    for (int i = 0; i < threads; ++i)
+    {
+        args[i].gate = &gate;
+        args[i].draws = draws;
+        args[i].output = output ? output + (size_t)i * draws : NULL;
+        if (pthread_create(&ids[i], &attr, worker, &args[i]) != 0)
+            break;
+        started++;
+    }
+
+    // Time from the moment every started worker is waiting at the gate
+    pthread_mutex_lock(&gate.lock);
+    while (gate.waiting < started)
+        pthread_cond_wait(&gate.changed, &gate.lock);
+    gate.open = 1;
+    double start = seconds_now();
+    pthread_cond_broadcast(&gate.changed);
+    pthread_mutex_unlock(&gate.lock);
+
+    int failed = started != threads;
+    for (int i = 0; i < started; ++i)
+    {
+        pthread_join(ids[i], NULL);
+        failed |= args[i].failed;
+    }
+    double elapsed = seconds_now() - start;
+
+    pthread_attr_destroy(&attr);
+    pthread_mutex_destroy(&gate.lock);
+    pthread_cond_destroy(&gate.changed);
+    free(ids);
+    free(args);
+    return failed ? -1.0 : elapsed;
+}
+
+int compare_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+int check_unique(int mode)
+{
+    size_t count = (size_t)CHECK_THREADS * CHECK_DRAWS;
+    uint64_t* words = malloc(count * sizeof(uint64_t));
+    if (!words)
+        return 0;
+
+    int ok = run_threads(CHECK_THREADS, CHECK_DRAWS, words) >= 0.0;
+    if (ok)
+    {
+        qsort(words, count, sizeof(uint64_t), compare_u64);
+        for (size_t i = 1; i < count; ++i)
+        {
+            if (words[i] == words[i - 1])
+            {
+                fprintf(stderr, "Error: %s mode handed out a word twice\n", mode_names[mode]);
+                ok = 0;
+                break;
+            }
+        }
+    }
+
+    pm_free(words, (int)(count * sizeof(uint64_t)));
+    return ok;
+}
+
+// The child's next word must differ from the parent's next word
+int check_fork(int mode)
+{
+    uint64_t parent_word = 0;
+    uint64_t child_word = 0;
+    int pipe_fds[2];
+
+    // Leaves most of a buffer behind for the child to inherit
+    if (pm_buffered_u64(&parent_word) != 0 || pipe(pipe_fds) != 0)
+        return 0;
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        int status = pm_buffered_u64(&child_word);
+        ssize_t written = write(pipe_fds[1], &child_word, sizeof(child_word));
+        _exit(status == 0 && written == (ssize_t)sizeof(child_word) ? 0 : 1);
+    }
+    if (pid < 0)
+    {
+        perror("fork");
+        return 0;
+    }
+
+    int child_status = 0;
+    int ok = read(pipe_fds[0], &child_word, sizeof(child_word)) == (ssize_t)sizeof(child_word);
+    waitpid(pid, &child_status, 0);
+    ok &= WIFEXITED(child_status) && WEXITSTATUS(child_status) == 0;
+    ok &= pm_buffered_u64(&parent_word) == 0 && parent_word != child_word;
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    if (!ok)
+        fprintf(stderr, "Error: %s mode repeated the parent's words after fork\n", mode_names[mode]);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    int thread_counts[] = { 1000, 5000, 10000 };
+    int thread_runs = 3;
+    int failed = 0;
+
+    if (argc > 1)
+    {
+        thread_counts[0] = atoi(argv[1]);
+        thread_runs = 1;
+    }
+
+    printf("%-14s %8s %12s %14s\n", "mode", "threads", "time (ms)", "Mdraws/s");
+    for (int mode = PM_BUFFER_THREAD_LOCAL; mode <= PM_BUFFER_PER_CPU; ++mode)
+    {
+        int active = pm_buffered_set_mode(mode);
+        if (active != mode)
+            printf("%s mode unavailable, using %s\n", mode_names[mode], mode_names[active]);
+
+        if (!check_unique(mode) || !check_fork(mode))
+            failed = 1;
+
+        for (int r = 0; r < thread_runs; ++r)
+        {
+            int threads = thread_counts[r];
+            double elapsed = run_threads(threads, DRAWS_PER_THREAD, NULL);
+            if (elapsed < 0.0)
+            {
+                fprintf(stderr, "Error: %s run with %d threads failed\n", mode_names[mode], threads);
+                failed = 1;
+                continue;
+            }
+
+            double draws = (double)threads * DRAWS_PER_THREAD;
+            printf("%-14s %8d %12.1f %14.2f\n", mode_names[mode], threads, elapsed * 1e3, draws / elapsed / 1e6);
+        }
+    }
+
+    printf("Buffered modes: %s\n", failed ? "FAILED" : "OK");
+    return failed;
+}
+#endif
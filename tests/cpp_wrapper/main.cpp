@@ -0,0 +1,171 @@
+#include <PRNG_mini.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Built as C++17 and C++20; std::span overloads exist only where the library has span.
+#ifdef __cpp_lib_span
+#define SPAN_OR_POINTER(array) std::span<std::remove_reference_t<decltype(array[0])>>(array)
+#else
+#define SPAN_OR_POINTER(array) array.data(), array.size()
+#endif
+
+static int failures = 0;
+
+#define CHECK(expr)                                                 \
+    do                                                              \
+    {                                                               \
+        if (!(expr))                                                \
+        {                                                           \
+            std::fprintf(stderr, "FAILED: %s (line %d)\n", #expr, __LINE__); \
+            failures++;                                             \
+        }                                                           \
+    } while (0)
+
+int main()
+{
+    pm::engine rng;
+
+    // UniformRandomBitGenerator: <random> and <algorithm> interoperability
+    std::uniform_int_distribution<int> dist(1, 6);
+    for (int i = 0; i < 1000; ++i)
+    {
+        int roll = dist(rng);
+        CHECK(roll >= 1 && roll <= 6);
+    }
+
+    std::vector<int> deck(52);
+    std::iota(deck.begin(), deck.end(), 0);
+    std::shuffle(deck.begin(), deck.end(), rng);
+    std::vector<int> sorted = deck;
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < 52; ++i)
+        CHECK(sorted[i] == i);
+
+    pm::buffered_engine shared;
+    std::shuffle(deck.begin(), deck.end(), shared);
+    sorted = deck;
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < 52; ++i)
+        CHECK(sorted[i] == i);
+
+    // Compile-time bounded draws: power-of-two and rejection paths
+    std::array<int, 20> histogram = {};
+    for (int i = 0; i < 100000; ++i)
+    {
+        auto value = rng.uniform<0, 19>();
+        CHECK(value <= 19);
+        histogram[value]++;
+    }
+    for (int count : histogram)
+        CHECK(count > 4000 && count < 6000);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto value = rng.uniform<16, 31>();
+        CHECK(value >= 16 && value <= 31);
+        auto runtime_value = rng.uniform(100, 102);
+        CHECK(runtime_value >= 100 && runtime_value <= 102);
+    }
+
+    pm::engine64 rng64;
+    CHECK((rng64.uniform<0, 0xFFFFFFFFFFFFFFFFull>() != 0 || rng64() != 0));
+
+    // Bulk fills through std::span, or pointer and length before C++20
+    std::array<std::uint8_t, 10000> large = {};
+    pm::fill(SPAN_OR_POINTER(large));
+    CHECK(std::any_of(large.begin(), large.end(), [](std::uint8_t b) { return b != 0; }));
+
+    std::array<std::uint16_t, 7> small = {};
+    rng.fill(SPAN_OR_POINTER(small));
+    CHECK(std::any_of(small.begin(), small.end(), [](std::uint16_t v) { return v != 0; }));
+
+    std::array<int, 256> dice = {};
+    pm::fill_integers(SPAN_OR_POINTER(dice), 1, 6);
+    for (int value : dice)
+        CHECK(value >= 1 && value <= 6);
+
+    // Caller-supplied engines: 32-bit, 64-bit and the library's buffered one
+    dice.fill(0);
+    pm::fill_integers(rng, SPAN_OR_POINTER(dice), 1, 6);
+    for (int value : dice)
+        CHECK(value >= 1 && value <= 6);
+    pm::fill_integers(rng64, SPAN_OR_POINTER(dice), -3, -1);
+    for (int value : dice)
+        CHECK(value >= -3 && value <= -1);
+    pm::fill_integers(shared, SPAN_OR_POINTER(dice), 0, 0);
+    for (int value : dice)
+        CHECK(value == 0);
+
+    // Full int range: no overflow in max - min + 1, both signs show up
+    std::array<int, 256> wide = {};
+    pm::fill_integers(SPAN_OR_POINTER(wide), std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    CHECK(std::any_of(wide.begin(), wide.end(), [](int v) { return v < 0; }));
+    CHECK(std::any_of(wide.begin(), wide.end(), [](int v) { return v > 0; }));
+    wide.fill(0);
+    pm::fill_integers(rng, SPAN_OR_POINTER(wide), std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    CHECK(std::any_of(wide.begin(), wide.end(), [](int v) { return v < 0; }));
+    CHECK(std::any_of(wide.begin(), wide.end(), [](int v) { return v > 0; }));
+
+    bool rejected = false;
+    try
+    {
+        pm::fill_integers(SPAN_OR_POINTER(dice), 6, 1);
+    }
+    catch (const std::invalid_argument&)
+    {
+        rejected = true;
+    }
+    CHECK(rejected);
+
+    rejected = false;
+    try
+    {
+        (void)rng.uniform(7, 3);
+    }
+    catch (const std::invalid_argument&)
+    {
+        rejected = true;
+    }
+    CHECK(rejected);
+
+    // RAII owners replacing pm_free(ptr, size) pairs
+    {
+        pm::secure_buffer<std::uint8_t> bytes = pm::random_bytes(64);
+        CHECK(bytes.size() == 64);
+        pm::secure_buffer<int> integers = pm::random_integers(32, -5, 5);
+        for (int value : integers)
+            CHECK(value >= -5 && value <= 5);
+        pm::secure_buffer<int> moved = std::move(integers);
+        CHECK(integers.empty() && moved.size() == 32);
+    }
+
+    // count * sizeof(T) would wrap to a small allocation
+    rejected = false;
+    try
+    {
+        pm::secure_buffer<int> huge(std::numeric_limits<std::size_t>::max() / 2);
+    }
+    catch (const std::bad_alloc&)
+    {
+        rejected = true;
+    }
+    CHECK(rejected);
+
+    std::string id = pm::guid();
+    CHECK(id.size() == 36 && id[14] == '4');
+
+    std::string key = pm::license_key(210);
+    CHECK(key.size() == 19);
+
+    std::printf("%s\n%s\n", id.c_str(), key.c_str());
+    std::printf("C++ wrapper: %s\n", failures == 0 ? "OK" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
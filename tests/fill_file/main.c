@@ -0,0 +1,125 @@
+#include <PRNG_mini.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+typedef struct {
+    const char* output_file;
+    uint64_t size_mb;
+    int keep_output;        // set by -out; the default temporary file is removed
+} Options;
+
+void parse_arguments(int argc, char** argv, Options* opts)
+{
+    opts->output_file = "fill_file_test.bin";
+    opts->size_mb = 16;
+    opts->keep_output = 0;
+
+    for (int i = 1; i < argc - 1; ++i)
+    {
+        if (strcmp(argv[i], "-out") == 0)
+        {
+            opts->output_file = argv[i + 1];
+            opts->keep_output = 1;
+        }
+        else if (strcmp(argv[i], "-mb") == 0)
+        {
+            opts->size_mb = strtoull(argv[i + 1], NULL, 10);
+        }
+    }
+}
+
+double seconds_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Chi-square over byte values: mean 255, sigma ~22.6; accept a symmetric 4-sigma band
+int check_byte_distribution(const uint8_t* data, size_t length)
+{
+    static uint64_t histogram[256];
+    memset(histogram, 0, sizeof(histogram));
+    for (size_t i = 0; i < length; ++i)
+        histogram[data[i]]++;
+
+    double expected = (double)length / 256.0;
+    double chi_square = 0.0;
+    for (int i = 0; i < 256; ++i)
+    {
+        double delta = (double)histogram[i] - expected;
+        chi_square += delta * delta / expected;
+    }
+
+    printf("Chi-square over %zu bytes: %.1f (255 expected)\n", length, chi_square);
+    return chi_square > 165.0 && chi_square < 345.0;
+}
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    parse_arguments(argc, argv, &opts);
+
+    uint64_t size = opts.size_mb << 20;
+    int failed = 0;
+
+    // Large in-memory fill
+    void* buffer = NULL;
+    size_t buffer_size = (size_t)8 << 20;
+    if (pm_get_random_bytes_large(&buffer, buffer_size) != 0 || buffer == NULL)
+    {
+        fprintf(stderr, "Error: pm_get_random_bytes_large failed\n");
+        return 1;
+    }
+    if (!check_byte_distribution((const uint8_t*)buffer, buffer_size))
+        failed = 1;
+    pm_free_large(buffer, buffer_size);
+
+    // Streamed file fill
+    double start = seconds_now();
+    int result = pm_fill_file(opts.output_file, size);
+    double elapsed = seconds_now() - start;
+    if (result != 0)
+    {
+        fprintf(stderr, "Error: pm_fill_file failed with %d\n", result);
+        if (!opts.keep_output)
+            remove(opts.output_file);
+        return 1;
+    }
+
+    printf("Wrote %llu MiB to %s in %.3f s (%.1f MiB/s)\n",
+        (unsigned long long)opts.size_mb, opts.output_file, elapsed,
+        elapsed > 0.0 ? (double)opts.size_mb / elapsed : 0.0);
+
+    FILE* f = fopen(opts.output_file, "rb");
+    if (!f)
+    {
+        perror("Failed to open output file");
+        if (!opts.keep_output)
+            remove(opts.output_file);
+        return 1;
+    }
+
+    uint8_t* head = malloc(1 << 20);
+    size_t head_size = head ? fread(head, 1, 1 << 20, f) : 0;
+    fseek(f, 0, SEEK_END);
+    long long file_size = (long long)ftell(f);
+    fclose(f);
+
+    if ((uint64_t)file_size != size)
+    {
+        fprintf(stderr, "Error: file size %lld, expected %llu\n", file_size, (unsigned long long)size);
+        failed = 1;
+    }
+    if (head_size > 0 && !check_byte_distribution(head, head_size))
+        failed = 1;
+    pm_free(head, 1 << 20);
+    if (!opts.keep_output)
+        remove(opts.output_file);
+
+    printf("Fill file: %s\n", failed ? "FAILED" : "OK");
+    return failed;
+}
@@ -0,0 +1,173 @@
+#include <PRNG_mini.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+// Issued keys in the index and absent keys probed against it
+#define ISSUED_KEYS     1000000
+#define PROBE_KEYS      1000000
+#define GENERATED_KEYS  20
+#define KEY_LENGTH      20      // 16 symbols + 3 dashes + null terminator
+
+double seconds_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Random keys in the license key alphabet; much faster to produce than signed keys
+char* make_random_keys(int count, char** pointers)
+{
+    char* storage = malloc((size_t)count * KEY_LENGTH);
+    int* symbols = NULL;
+    if (!storage || pm_get_random_integers(&symbols, count * 16, 0, 35) != 0)
+    {
+        free(storage);
+        return NULL;
+    }
+
+    for (int k = 0; k < count; ++k)
+    {
+        char* key = storage + (size_t)k * KEY_LENGTH;
+        int idx = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            int value = symbols[k * 16 + i];
+            key[idx++] = (char)(value < 10 ? '0' + value : 'A' + value - 10);
+            if ((i + 1) % 4 == 0 && i != 15)
+                key[idx++] = '-';
+        }
+        key[idx] = '\0';
+        pointers[k] = key;
+    }
+
+    pm_free(symbols, count * 16 * (int)sizeof(int));
+    return storage;
+}
+
+int check_set(const char* label, const pm_keyset* set, const char* const* issued, const char* const* probes, uint8_t* results)
+{
+    int failed = 0;
+
+    double start = seconds_now();
+    long long found = pm_keyset_contains_batch(set, issued, ISSUED_KEYS, results);
+    double batch_hit = seconds_now() - start;
+    if (found != ISSUED_KEYS)
+    {
+        fprintf(stderr, "Error: %s: %lld of %d issued keys found\n", label, found, ISSUED_KEYS);
+        failed = 1;
+    }
+
+    start = seconds_now();
+    found = pm_keyset_contains_batch(set, probes, PROBE_KEYS, results);
+    double batch_miss = seconds_now() - start;
+    if (found != 0)
+    {
+        fprintf(stderr, "Error: %s: %lld absent keys reported present\n", label, found);
+        failed = 1;
+    }
+
+    start = seconds_now();
+    long long single = 0;
+    for (int i = 0; i < PROBE_KEYS; ++i)
+        single += pm_keyset_contains(set, (i & 1) ? probes[i] : issued[i]);
+    double single_mixed = seconds_now() - start;
+    if (single != PROBE_KEYS / 2)
+    {
+        fprintf(stderr, "Error: %s: single lookups found %lld\n", label, single);
+        failed = 1;
+    }
+
+    printf("%-16s batch hit %6.1f ns/key, batch miss %6.1f ns/key, single mixed %6.1f ns/key\n", label,
+        batch_hit * 1e9 / ISSUED_KEYS, batch_miss * 1e9 / PROBE_KEYS, single_mixed * 1e9 / PROBE_KEYS);
+    return failed;
+}
+
+int main(void)
+{
+    int failed = 0;
+    char** issued = malloc(sizeof(char*) * (ISSUED_KEYS + GENERATED_KEYS));
+    char** probes = malloc(sizeof(char*) * PROBE_KEYS);
+    uint8_t* results = malloc(ISSUED_KEYS + GENERATED_KEYS);
+    char* issued_storage = issued ? make_random_keys(ISSUED_KEYS, issued) : NULL;
+    char* probe_storage = probes ? make_random_keys(PROBE_KEYS, probes) : NULL;
+    if (!results || !issued_storage || !probe_storage)
+    {
+        fprintf(stderr, "Error: key generation failed\n");
+        return 1;
+    }
+
+    // A few keys from the real generator, mixed with the synthetic ones
+    for (int i = 0; i < GENERATED_KEYS; ++i)
+    {
+        char* key = NULL;
+        if (pm_get_license_key(&key, 210) < 0 || !key)
+        {
+            fprintf(stderr, "Error: pm_get_license_key failed\n");
+            return 1;
+        }
+        issued[ISSUED_KEYS + i] = key;
+    }
+
+    pm_keyset* plain = NULL;
+    pm_keyset* filtered = NULL;
+    double start = seconds_now();
+    if (pm_keyset_create(&plain, (const char* const*)issued, ISSUED_KEYS + GENERATED_KEYS, 0) != 0
+        || pm_keyset_create(&filtered, (const char* const*)issued, ISSUED_KEYS + GENERATED_KEYS, 10) != 0)
+    {
+        fprintf(stderr, "Error: pm_keyset_create failed\n");
+        return 1;
+    }
+    printf("Built two sets of %zu keys in %.2f s\n", pm_keyset_size(plain), seconds_now() - start);
+
+    failed |= check_set("sorted table", plain, (const char* const*)issued, (const char* const*)probes, results);
+    failed |= check_set("with Bloom", filtered, (const char* const*)issued, (const char* const*)probes, results);
+
+    // Generated keys, lowercase and malformed input
+    for (int i = 0; i < GENERATED_KEYS; ++i)
+        failed |= pm_keyset_contains(filtered, issued[ISSUED_KEYS + i]) != 1;
+
+    char lowered[KEY_LENGTH];
+    strcpy(lowered, issued[0]);
+    for (char* c = lowered; *c; ++c)
+        if (*c >= 'A' && *c <= 'Z')
+            *c = (char)(*c - 'A' + 'a');
+    failed |= pm_keyset_contains(plain, lowered) != 1;
+    failed |= pm_keyset_contains(plain, "NOT-A-KEY") != 0;
+    failed |= pm_keyset_contains(plain, "ABCD-EFGH-IJKL-MNOP-Q") != 0;
+
+    // Round trip through a memory-mapped file
+    const char* path = "keyset.bin";
+    pm_keyset* mapped = NULL;
+    if (pm_keyset_save(filtered, path) != 0 || pm_keyset_open(&mapped, path) != 0)
+    {
+        fprintf(stderr, "Error: keyset save/open failed\n");
+        failed = 1;
+    }
+    else
+    {
+        failed |= check_set("mapped file", mapped, (const char* const*)issued, (const char* const*)probes, results);
+        pm_keyset_free(mapped);
+    }
+    remove(path);
+
+    pm_keyset* empty = NULL;
+    failed |= pm_keyset_create(&empty, NULL, 0, 10) != 0 || pm_keyset_contains(empty, issued[0]) != 0;
+    pm_keyset_free(empty);
+
+    pm_keyset_free(plain);
+    pm_keyset_free(filtered);
+    for (int i = 0; i < GENERATED_KEYS; ++i)
+        pm_free(issued[ISSUED_KEYS + i], KEY_LENGTH);
+    free(issued_storage);
+    free(probe_storage);
+    free(issued);
+    free(probes);
+    free(results);
+
+    printf("Keyset: %s\n", failed ? "FAILED" : "OK");
+    return failed;
+}
@@ -0,0 +1,332 @@
+#include <PRNG_mini.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef _WIN32
+int main(void)
+{
+    printf("Nonce test requires POSIX threads and fork(); skipped.\n");
+    return 0;
+}
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// Threads issuing nonces concurrently and nonces each of them issues
+#define THREADS             8
+#define NONCES_PER_THREAD   200000
+#define BATCH               64
+
+typedef struct
+{
+    pm_nonce_gen* gen;
+    uint8_t* output;        // NONCES_PER_THREAD nonces
+    int use_batch;
+    int failed;
+} WorkerArgs;
+
+double seconds_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int compare_nonce(const void* a, const void* b)
+{
+    return memcmp(a, b, PM_NONCE_SIZE);
+}
+
+// Sorts the nonces and reports whether any two are equal
+int has_duplicates(uint8_t* nonces, size_t count)
+{
+    qsort(nonces, count, PM_NONCE_SIZE, compare_nonce);
+    for (size_t i = 1; i < count; ++i)
+        if (memcmp(nonces + (i - 1) * PM_NONCE_SIZE, nonces + i * PM_NONCE_SIZE, PM_NONCE_SIZE) == 0)
+            return 1;
+    return 0;
+}
+
+void* worker(void* argument)
+{
+    WorkerArgs* args = (WorkerArgs*)argument;
+    uint64_t epoch = 0;
+    uint64_t first_epoch = 0;
+    int have_epoch = 0;
+    int issued = 0;
+
+    while (issued < NONCES_PER_THREAD)
+    {
+        uint8_t* out = args->output + (size_t)issued * PM_NONCE_SIZE;
+        if (args->use_batch)
+        {
+            size_t want = NONCES_PER_THREAD - issued < BATCH ? (size_t)(NONCES_PER_THREAD - issued) : BATCH;
+            long long written = pm_nonce_batch(args->gen, out, want, &epoch);
+            if (written <= 0)
+            {
+                args->failed = 1;
+                break;
+            }
+            issued += (int)written;
+        }
+        else
+        {
+            if (pm_nonce_next(args->gen, out, &epoch) != 0)
+            {
+                args->failed = 1;
+                break;
+            }
+            issued++;
+        }
+        // Epoch numbers are opaque; the generator must stay in its first one
+        if (!have_epoch)
+        {
+            first_epoch = epoch;
+            have_epoch = 1;
+        }
+        args->failed |= epoch != first_epoch;
+    }
+    return NULL;
+}
+
+int check_threads(int use_batch)
+{
+    pm_nonce_gen* gen = NULL;
+    size_t total = (size_t)THREADS * NONCES_PER_THREAD;
+    uint8_t* nonces = malloc(total * PM_NONCE_SIZE);
+    pthread_t ids[THREADS];
+    WorkerArgs args[THREADS];
+    int failed = 0;
+
+    if (!nonces || pm_nonce_create(&gen, 32, 1024, 0) != 0)
+    {
+        free(nonces);
+        return 1;
+    }
+
+    double start = seconds_now();
+    for (int i = 0; i < THREADS; ++i)
+    {
+        args[i].gen = gen;
+        args[i].output = nonces + (size_t)i * NONCES_PER_THREAD * PM_NONCE_SIZE;
+        args[i].use_batch = use_batch;
+        args[i].failed = 0;
+        if (pthread_create(&ids[i], NULL, worker, &args[i]) != 0)
+        {
+            fprintf(stderr, "Error: pthread_create failed\n");
+            return 1;
+        }
+    }
+    for (int i = 0; i < THREADS; ++i)
+    {
+        pthread_join(ids[i], NULL);
+        failed |= args[i].failed;
+    }
+    printf("%s: %.1f ns per nonce over %d threads\n", use_batch ? "pm_nonce_batch" : "pm_nonce_next",
+        (seconds_now() - start) * 1e9 / (double)total, THREADS);
+
+    // One epoch: the 8-byte random prefix is shared and the counters are all distinct
+    for (size_t i = 1; i < total; ++i)
+        failed |= memcmp(nonces, nonces + i * PM_NONCE_SIZE, 8) != 0;
+    if (has_duplicates(nonces, total))
+    {
+        fprintf(stderr, "Error: duplicate nonce across threads\n");
+        failed = 1;
+    }
+
+    pm_nonce_free(gen);
+    free(nonces);
+    return failed;
+}
+
+int check_exhaustion(void)
+{
+    pm_nonce_gen* gen = NULL;
+    enum { LIMIT = 1000, DRAWN = 5500 };
+    uint8_t* nonces = malloc((size_t)DRAWN * PM_NONCE_SIZE);
+    int per_epoch[8] = { 0 };
+    uint64_t first = 0;
+    uint64_t epoch = 0;
+    int failed = 0;
+
+    if (!nonces || pm_nonce_create(&gen, 16, 64, LIMIT) != 0)
+    {
+        free(nonces);
+        return 1;
+    }
+
+    for (int i = 0; i < DRAWN; ++i)
+    {
+        failed |= pm_nonce_next(gen, nonces + (size_t)i * PM_NONCE_SIZE, &epoch) != 0;
+        if (i == 0)
+            first = epoch;
+        // Within one process, epochs are numbered consecutively
+        if (epoch - first < 8)
+            per_epoch[epoch - first]++;
+        else
+            failed = 1;
+    }
+    // Every epoch but the last is used up exactly
+    for (int e = 0; e < 5; ++e)
+        failed |= per_epoch[e] != LIMIT;
+    failed |= per_epoch[5] != DRAWN - 5 * LIMIT;
+
+    // A batch stops at the epoch boundary: 500 left in epoch 5
+    uint8_t batch[600 * PM_NONCE_SIZE];
+    failed |= pm_nonce_batch(gen, batch, 600, &epoch) != 500 || epoch != first + 5;
+    failed |= pm_nonce_batch(gen, batch, 600, &epoch) != 600 || epoch != first + 6;
+
+    // Explicit rekey moves on and changes the prefix
+    uint8_t before[PM_NONCE_SIZE];
+    uint8_t after[PM_NONCE_SIZE];
+    failed |= pm_nonce_next(gen, before, NULL) != 0;
+    failed |= pm_nonce_rekey(gen, &epoch) != 0 || epoch != first + 7;
+    failed |= pm_nonce_next(gen, after, &epoch) != 0 || epoch != first + 7;
+    failed |= memcmp(before, after, 10) == 0;
+    // The counter restarts at zero in the new epoch
+    failed |= after[10] != 0 || after[11] != 0;
+
+    if (has_duplicates(nonces, DRAWN))
+        failed = 1;
+
+    if (failed)
+        fprintf(stderr, "Error: exhaustion and rekey checks failed\n");
+    pm_nonce_free(gen);
+    free(nonces);
+    return failed;
+}
+
+int check_fork(void)
+{
+    pm_nonce_gen* gen = NULL;
+    uint8_t parent_nonce[PM_NONCE_SIZE];
+    uint8_t child_nonce[PM_NONCE_SIZE];
+    uint64_t epoch = 0;
+    int pipe_fds[2];
+    int failed = 0;
+
+    if (pm_nonce_create(&gen, 32, 1024, 0) != 0 || pm_nonce_next(gen, parent_nonce, &epoch) != 0 || pipe(pipe_fds) != 0)
+        return 1;
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // The child inherits the parent's block; it must move to its own epoch
+        uint64_t child_epoch = 0;
+        int status = pm_nonce_next(gen, child_nonce, &child_epoch);
+        uint8_t report[1 + sizeof(uint64_t)];
+        report[0] = status == 0 && child_epoch != epoch && memcmp(child_nonce, parent_nonce, 8) != 0;
+        memcpy(report + 1, &child_epoch, sizeof(child_epoch));
+        ssize_t written = write(pipe_fds[1], report, sizeof(report));
+        _exit(written == (ssize_t)sizeof(report) ? 0 : 1);
+    }
+    if (pid < 0)
+    {
+        perror("fork");
+        return 1;
+    }
+
+    uint8_t report[1 + sizeof(uint64_t)] = { 0 };
+    uint64_t child_epoch = 0;
+    int child_status = 0;
+    failed |= read(pipe_fds[0], report, sizeof(report)) != (ssize_t)sizeof(report) || report[0] != 1;
+    memcpy(&child_epoch, report + 1, sizeof(child_epoch));
+    waitpid(pid, &child_status, 0);
+    failed |= !WIFEXITED(child_status) || WEXITSTATUS(child_status) != 0;
+
+    // The parent carries on in its own epoch
+    uint64_t parent_epoch = 1;
+    failed |= pm_nonce_next(gen, parent_nonce, &parent_epoch) != 0 || parent_epoch != epoch;
+
+    // The parent's next epoch has the same sequence as the child's first one, yet
+    // a different number
+    failed |= pm_nonce_rekey(gen, &parent_epoch) != 0 || parent_epoch == child_epoch || parent_epoch == epoch;
+    failed |= (uint32_t)parent_epoch != (uint32_t)child_epoch;
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    if (failed)
+        fprintf(stderr, "Error: fork checks failed\n");
+    pm_nonce_free(gen);
+    return failed;
+}
+
+int check_reclaim(void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    enum { ROLLOVERS = 50000 };
+    pm_nonce_gen* gen = NULL;
+    uint8_t nonce[PM_NONCE_SIZE];
+    int failed = 0;
+
+    if (pm_nonce_create(&gen, 32, 64, 0) != 0)
+        return 1;
+
+    // Retired epochs are freed as they go; keeping them all would take several MB
+    size_t before = mallinfo2().uordblks;
+    for (int i = 0; i < ROLLOVERS && !failed; ++i)
+        failed |= pm_nonce_next(gen, nonce, NULL) != 0 || pm_nonce_rekey(gen, NULL) != 0;
+    size_t after = mallinfo2().uordblks;
+
+    long long growth = (long long)after - (long long)before;
+    printf("pm_nonce_rekey: heap grew %lld bytes over %d rollovers\n", growth, ROLLOVERS);
+    failed |= growth > 64 * 1024;
+
+    if (failed)
+        fprintf(stderr, "Error: retired epochs were not reclaimed\n");
+    pm_nonce_free(gen);
+    return failed;
+#else
+    printf("pm_nonce_rekey: heap statistics need glibc; reclaim check skipped\n");
+    return 0;
+#endif
+}
+
+int check_arguments(void)
+{
+    pm_nonce_gen* gen = NULL;
+    uint8_t nonce[PM_NONCE_SIZE];
+    int failed = 0;
+
+    failed |= pm_nonce_create(&gen, 15, 1024, 0) != -1;
+    failed |= pm_nonce_create(&gen, 65, 1024, 0) != -1;
+    failed |= pm_nonce_create(&gen, 32, 0, 0) != -1;
+    failed |= pm_nonce_create(NULL, 32, 1024, 0) != -1;
+    failed |= pm_nonce_next(NULL, nonce, NULL) != -1;
+    failed |= pm_nonce_batch(NULL, nonce, 1, NULL) != -1;
+
+    // Full 64-bit counter: the upper 4 bytes stay random, the counter fills the rest
+    failed |= pm_nonce_create(&gen, 64, 1, 0) != 0;
+    failed |= pm_nonce_batch(gen, nonce, 0, NULL) != -1;
+    failed |= pm_nonce_next(gen, nonce, NULL) != 0;
+    for (int i = 4; i < PM_NONCE_SIZE; ++i)
+        failed |= nonce[i] != 0;
+    pm_nonce_free(gen);
+
+    if (failed)
+        fprintf(stderr, "Error: argument checks failed\n");
+    return failed;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    failed |= check_threads(0);
+    failed |= check_threads(1);
+    failed |= check_exhaustion();
+    failed |= check_reclaim();
+    failed |= check_fork();
+    failed |= check_arguments();
+
+    printf("Nonce: %s\n", failed ? "FAILED" : "OK");
+    return failed;
+}
+#endif
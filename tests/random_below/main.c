@@ -0,0 +1,213 @@
+#include <PRNG_mini.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#define SAMPLES     100000
+#define BATCH       10000
+
+// NIST P-256 group order, big-endian
+static const uint8_t p256_order[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51
+};
+
+// Ed25519 group order l = 2^252 + 27742317777372353535851937790883648493, little-endian
+static const uint8_t ed25519_order[32] = {
+    0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58, 0xD6, 0x9C, 0xF7, 0xA2, 0xDE, 0xF9, 0xDE, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+};
+
+double seconds_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Plain reference comparison of big-endian values: -1, 0 or 1
+int compare_be(const uint8_t* a, const uint8_t* b, size_t len)
+{
+    return memcmp(a, b, len) < 0 ? -1 : (memcmp(a, b, len) > 0 ? 1 : 0);
+}
+
+void reverse(uint8_t* out, const uint8_t* in, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+        out[i] = in[len - 1 - i];
+}
+
+int in_range_be(const uint8_t* value, const uint8_t* modulus, size_t len)
+{
+    static const uint8_t zero[512] = { 0 };
+    return compare_be(value, zero, len) > 0 && compare_be(value, modulus, len) < 0;
+}
+
+int check_p256(void)
+{
+    uint8_t value[32];
+    int failed = 0;
+    // Top-byte histogram: the order is just below 2^256, so every top byte occurs
+    long long top[256] = { 0 };
+
+    double start = seconds_now();
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        if (pm_random_below(value, p256_order, sizeof(value)) != 0 || !in_range_be(value, p256_order, sizeof(value)))
+        {
+            fprintf(stderr, "Error: P-256 sample %d out of range\n", i);
+            return 1;
+        }
+        top[value[0]]++;
+    }
+    printf("P-256 scalars: %.0f ns each\n", (seconds_now() - start) * 1e9 / SAMPLES);
+
+    double expected = (double)SAMPLES / 256;
+    for (int b = 0; b < 256; ++b)
+        if (top[b] < expected * 0.7 || top[b] > expected * 1.3)
+        {
+            fprintf(stderr, "Error: P-256 top byte %02X seen %lld times (expected ~%.0f)\n", b, top[b], expected);
+            failed = 1;
+        }
+    return failed;
+}
+
+int check_ed25519(void)
+{
+    uint8_t* values = malloc((size_t)BATCH * 32);
+    uint8_t order_be[32];
+    uint8_t value_be[32];
+    int failed = 0;
+    long long high = 0;
+
+    reverse(order_be, ed25519_order, 32);
+    if (!values)
+        return 1;
+
+    double start = seconds_now();
+    if (pm_random_below_batch(values, BATCH, ed25519_order, 32, 1) != 0)
+    {
+        fprintf(stderr, "Error: pm_random_below_batch failed\n");
+        free(values);
+        return 1;
+    }
+    printf("Ed25519 scalars (batch): %.0f ns each\n", (seconds_now() - start) * 1e9 / BATCH);
+
+    for (int i = 0; i < BATCH; ++i)
+    {
+        reverse(value_be, values + (size_t)i * 32, 32);
+        if (!in_range_be(value_be, order_be, 32))
+        {
+            fprintf(stderr, "Error: Ed25519 sample %d out of range\n", i);
+            failed = 1;
+            break;
+        }
+        // Values at or above 2^252 need top byte 0x10; nearly none fit below l
+        high += value_be[0] == 0x10;
+    }
+    if (high > BATCH / 1000)
+    {
+        fprintf(stderr, "Error: %lld Ed25519 samples at or above 2^252\n", high);
+        failed = 1;
+    }
+
+    // Single little-endian draw agrees with the big-endian view of the same order
+    uint8_t single[32];
+    failed |= pm_random_below_le(single, ed25519_order, 32) != 0;
+    reverse(value_be, single, 32);
+    failed |= !in_range_be(value_be, order_be, 32);
+    failed |= pm_random_below(single, order_be, 32) != 0 || !in_range_be(single, order_be, 32);
+
+    free(values);
+    return failed;
+}
+
+int check_small_moduli(void)
+{
+    int failed = 0;
+    uint8_t modulus[32] = { 0 };
+    uint8_t value[32];
+    uint8_t zero[32] = { 0 };
+
+    // n = 2 leaves 1 as the only value
+    modulus[31] = 2;
+    for (int i = 0; i < 100; ++i)
+    {
+        failed |= pm_random_below(value, modulus, 32) != 0;
+        failed |= value[31] != 1 || memcmp(value, zero, 31) != 0;
+    }
+
+    // n = 3 gives 1 and 2 evenly
+    int counts[3] = { 0 };
+    modulus[31] = 3;
+    for (int i = 0; i < 10000; ++i)
+    {
+        failed |= pm_random_below(value, modulus, 32) != 0 || memcmp(value, zero, 31) != 0 || value[31] < 1 || value[31] > 2;
+        if (value[31] < 3)
+            counts[value[31]]++;
+    }
+    failed |= counts[1] < 4500 || counts[2] < 4500;
+
+    // n = 2^64 + 1: the top limb holds one bit, only 0 and 1 survive the mask there
+    memset(modulus, 0, sizeof(modulus));
+    modulus[23] = 1;
+    modulus[31] = 1;
+    for (int i = 0; i < 1000; ++i)
+    {
+        failed |= pm_random_below(value, modulus, 32) != 0 || !in_range_be(value, modulus, 32);
+    }
+
+    // Invalid moduli and lengths
+    modulus[23] = 0;
+    failed |= pm_random_below(value, modulus, 32) != -1;       // n = 1
+    modulus[31] = 0;
+    failed |= pm_random_below(value, modulus, 32) != -1;       // n = 0
+    failed |= pm_random_below(value, p256_order, 0) != -1;
+    failed |= pm_random_below(NULL, p256_order, 32) != -1;
+    failed |= pm_random_below_batch(value, 0, p256_order, 32, 0) != -1;
+
+    if (failed)
+        fprintf(stderr, "Error: small modulus checks failed\n");
+    return failed;
+}
+
+int check_rsa_sizes(void)
+{
+    static uint8_t modulus[512];
+    static uint8_t values[4 * 512];
+    int failed = 0;
+
+    // 4096-bit odd modulus with a sparse top byte, as for blinding factors
+    for (size_t i = 0; i < sizeof(modulus); ++i)
+        modulus[i] = (uint8_t)(0x5A ^ i);
+    modulus[0] = 0x83;
+    modulus[511] |= 1;
+
+    failed |= pm_random_below_batch(values, 4, modulus, 512, 0) != 0;
+    for (int i = 0; i < 4; ++i)
+        failed |= !in_range_be(values + i * 512, modulus, 512);
+
+    // Lengths above 4096 bits are refused
+    static uint8_t too_long[513];
+    too_long[0] = 1;
+    failed |= pm_random_below(values, too_long, sizeof(too_long)) != -1;
+
+    if (failed)
+        fprintf(stderr, "Error: 4096-bit checks failed\n");
+    return failed;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    failed |= check_p256();
+    failed |= check_ed25519();
+    failed |= check_small_moduli();
+    failed |= check_rsa_sizes();
+
+    printf("Random below: %s\n", failed ? "FAILED" : "OK");
+    return failed;
+}
@@ -0,0 +1,334 @@
+#include <PRNG_mini.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+int main(void)
+{
+    printf("Randomness service requires Unix sockets; skipped.\n");
+    return 0;
+}
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#define CLIENTS             8
+#define WORDS_PER_CLIENT    20000
+#define RING_BLOCKS         64
+
+// Clients killed while drawing whole blocks, most of them inside a dequeue
+#define KILLED_CLIENTS      24
+
+static volatile sig_atomic_t daemon_stop = 0;
+
+void handle_stop(int signal_number)
+{
+    (void)signal_number;
+    daemon_stop = 1;
+}
+
+pid_t start_daemon(const char* socket_path)
+{
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        signal(SIGTERM, handle_stop);
+        int status = pm_service_run(socket_path, RING_BLOCKS, (const volatile int*)&daemon_stop);
+        _exit(status == 0 ? 0 : 1);
+    }
+    return pid;
+}
+
+int connect_with_retry(const char* socket_path)
+{
+    for (int attempt = 0; attempt < 200; ++attempt)
+    {
+        if (pm_service_connect(socket_path) == 0)
+            return 0;
+        usleep(10000);
+    }
+    return -1;
+}
+
+// Client process: draws words through the service and records them in shared memory
+int run_client(const char* socket_path, uint64_t* words)
+{
+    if (connect_with_retry(socket_path) != 0)
+        return 1;
+
+    for (int i = 0; i < WORDS_PER_CLIENT; ++i)
+    {
+        if (pm_service_bytes(&words[i], sizeof(uint64_t)) != 0)
+            return 1;
+    }
+
+    uint64_t blocks = 0;
+    pm_service_stats(&blocks, NULL);
+    pm_service_disconnect();
+    return blocks > 0 ? 0 : 2;
+}
+
+void kill_self(int signal_number)
+{
+    (void)signal_number;
+    raise(SIGKILL);
+}
+
+// Client process that draws whole blocks until it kills itself. The user-time timer
+// only expires while the client runs its own code, which is mostly the block copy
+// and wipe inside a dequeue, so the kill lands between claiming and returning a block.
+int run_victim(const char* socket_path, int user_microseconds)
+{
+    uint8_t block[4096];
+    if (connect_with_retry(socket_path) != 0)
+        return 1;
+
+    struct itimerval timer = { { 0, 0 }, { 0, user_microseconds } };
+    signal(SIGVTALRM, kill_self);
+    setitimer(ITIMER_VIRTUAL, &timer, NULL);
+    for (;;)
+        pm_service_bytes(block, sizeof(block));
+}
+
+// Client process that needs the ring to lap several times: fails if blocks left
+// behind by killed clients are never reclaimed
+int run_after_kills(const char* socket_path)
+{
+    uint8_t block[4096];
+    uint64_t blocks = 0;
+    if (connect_with_retry(socket_path) != 0)
+        return 1;
+
+    time_t deadline = time(NULL) + 10;
+    while (blocks < 4 * RING_BLOCKS && time(NULL) < deadline)
+    {
+        uint64_t before = blocks;
+        if (pm_service_bytes(block, sizeof(block)) != 0)
+            return 1;
+        pm_service_stats(&blocks, NULL);
+        if (blocks == before)
+            usleep(1000); // ring stalled or empty: give the daemon time to reclaim
+    }
+    pm_service_disconnect();
+    return blocks >= 4 * RING_BLOCKS ? 0 : 2;
+}
+
+// Fake daemon: answers one connection with a wrong tag but a descriptor attached,
+// which the client must close when it rejects the message
+int run_fake_daemon(int listener)
+{
+    int connection = accept(listener, NULL, NULL);
+    int passed = open("/dev/null", O_RDONLY);
+    if (connection < 0 || passed < 0)
+        return 1;
+
+    char tag = 'X';
+    struct iovec io = { &tag, 1 };
+    union
+    {
+        char buffer[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(header), &passed, sizeof(int));
+
+    int sent = sendmsg(connection, &message, 0) == 1;
+    close(passed);
+    close(connection);
+    return sent ? 0 : 1;
+}
+
+// A rejected reply must not leave its passed descriptor open in the client
+int check_rejected_fd(void)
+{
+    char fake_path[64];
+    snprintf(fake_path, sizeof(fake_path), "/tmp/pm_service_fake_%ld.sock", (long)getpid());
+    unlink(fake_path);
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, fake_path, sizeof(address.sun_path) - 1);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0
+        || chmod(fake_path, 0600) != 0 || listen(listener, 1) != 0)
+    {
+        perror("fake daemon");
+        return 1;
+    }
+
+    pid_t fake = fork();
+    if (fake == 0)
+        _exit(run_fake_daemon(listener));
+    close(listener);
+
+    // Descriptors from the lowest free one up must all still be free afterwards
+    int lowest = dup(0);
+    close(lowest);
+    int result = pm_service_connect(fake_path);
+    int leaked = -1;
+    for (int fd = lowest; fd < lowest + 16 && leaked < 0; ++fd)
+    {
+        if (fcntl(fd, F_GETFD) != -1)
+            leaked = fd;
+    }
+
+    int status = 0;
+    waitpid(fake, &status, 0);
+    unlink(fake_path);
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || result != -5 || leaked >= 0)
+    {
+        fprintf(stderr, "Error: rejected reply returned %d, descriptor %d left open\n", result, leaked);
+        return 1;
+    }
+    return 0;
+}
+
+int compare_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+int main(void)
+{
+    char socket_path[64];
+    snprintf(socket_path, sizeof(socket_path), "/tmp/pm_service_test_%ld.sock", (long)getpid());
+    int failed = 0;
+
+    // Without a daemon every request falls back to the in-process path
+    uint8_t probe[64];
+    if (pm_service_connect(socket_path) == 0 || pm_service_bytes(probe, sizeof(probe)) != 0)
+    {
+        fprintf(stderr, "Error: fallback without a daemon failed\n");
+        failed = 1;
+    }
+
+    if (check_rejected_fd() != 0)
+        failed = 1;
+
+    pid_t daemon_pid = start_daemon(socket_path);
+    if (daemon_pid < 0)
+    {
+        perror("fork");
+        return 1;
+    }
+
+    size_t words_size = sizeof(uint64_t) * CLIENTS * WORDS_PER_CLIENT;
+    uint64_t* words = mmap(NULL, words_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (words == MAP_FAILED)
+    {
+        perror("mmap");
+        kill(daemon_pid, SIGTERM);
+        return 1;
+    }
+
+    pid_t clients[CLIENTS];
+    for (int c = 0; c < CLIENTS; ++c)
+    {
+        clients[c] = fork();
+        if (clients[c] == 0)
+            _exit(run_client(socket_path, words + (size_t)c * WORDS_PER_CLIENT));
+    }
+
+    for (int c = 0; c < CLIENTS; ++c)
+    {
+        int status = 0;
+        waitpid(clients[c], &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            fprintf(stderr, "Error: client %d exited with %d\n", c, WEXITSTATUS(status));
+            failed = 1;
+        }
+    }
+
+    // Blocks are handed to exactly one consumer: no word may repeat across processes
+    size_t count = (size_t)CLIENTS * WORDS_PER_CLIENT;
+    qsort(words, count, sizeof(uint64_t), compare_u64);
+    for (size_t i = 1; i < count; ++i)
+    {
+        if (words[i] == words[i - 1])
+        {
+            fprintf(stderr, "Error: a word was handed out twice\n");
+            failed = 1;
+            break;
+        }
+    }
+    munmap(words, words_size);
+
+    // Clients killed mid-dequeue must not stall the ring for everyone else
+    for (int k = 0; k < KILLED_CLIENTS; ++k)
+    {
+        pid_t victim = fork();
+        if (victim == 0)
+            _exit(run_victim(socket_path, 1000 + 300 * k));
+        waitpid(victim, NULL, 0);
+    }
+    pid_t survivor = fork();
+    if (survivor == 0)
+        _exit(run_after_kills(socket_path));
+    int survivor_status = 0;
+    waitpid(survivor, &survivor_status, 0);
+    if (!WIFEXITED(survivor_status) || WEXITSTATUS(survivor_status) != 0)
+    {
+        fprintf(stderr, "Error: ring stalled after clients were killed (%d)\n", WEXITSTATUS(survivor_status));
+        failed = 1;
+    }
+
+    // Daemon gone: an attached client keeps working through the fallback
+    if (connect_with_retry(socket_path) != 0)
+    {
+        fprintf(stderr, "Error: could not attach to the daemon\n");
+        failed = 1;
+    }
+    kill(daemon_pid, SIGTERM);
+    int daemon_status = 0;
+    waitpid(daemon_pid, &daemon_status, 0);
+    if (!WIFEXITED(daemon_status) || WEXITSTATUS(daemon_status) != 0)
+    {
+        fprintf(stderr, "Error: daemon exited with %d\n", WEXITSTATUS(daemon_status));
+        failed = 1;
+    }
+
+    uint8_t drain[RING_BLOCKS * 4096 + 64];
+    uint64_t blocks = 0;
+    uint64_t fallbacks = 0;
+    if (pm_service_bytes(drain, sizeof(drain)) != 0)
+        failed = 1;
+    pm_service_stats(&blocks, &fallbacks);
+    pm_service_disconnect();
+
+    printf("Service: %d clients x %d words, %llu blocks from ring after shutdown, %llu fallbacks\n",
+        CLIENTS, WORDS_PER_CLIENT, (unsigned long long)blocks, (unsigned long long)fallbacks);
+    if (blocks != 0 || fallbacks < 2)
+        failed = 1;
+
+    printf("Service: %s\n", failed ? "FAILED" : "OK");
+    return failed;
+}
+#endif